@@ -62,6 +62,8 @@ class MPUnitsConan(ConanFile):
         "contracts": ["none", "gsl-lite", "ms-gsl"],
         "freestanding": [True, False],
         "natural_units": [True, False],
+        "profile_conversions": [True, False],
+        "conversion_diagnostics": [True, False],
     }
     default_options = {
         # "cxx_modules" default set in config_options()
@@ -72,6 +74,8 @@ class MPUnitsConan(ConanFile):
         "contracts": "gsl-lite",
         "freestanding": False,
         "natural_units": True,
+        "profile_conversions": False,
+        "conversion_diagnostics": False,
     }
     implements = ["auto_header_only"]
     exports = "LICENSE.md"
@@ -234,6 +238,14 @@ class MPUnitsConan(ConanFile):
             raise ConanInvalidConfiguration(
                 "'contracts' should be set to 'none' for a freestanding build"
             )
+        if self.options.freestanding and self.options.profile_conversions:
+            raise ConanInvalidConfiguration(
+                "'profile_conversions' is not available in a freestanding build"
+            )
+        if self.options.freestanding and self.options.conversion_diagnostics:
+            raise ConanInvalidConfiguration(
+                "'conversion_diagnostics' is not available in a freestanding build"
+            )
         # TODO mixing of `import std;` and regular header files includes does not work for now
         if self.options.import_std:
             if self.options.contracts != "none":
@@ -280,6 +292,8 @@ class MPUnitsConan(ConanFile):
         tc.cache_variables["MP_UNITS_API_NO_CRTP"] = opt.no_crtp
         tc.cache_variables["MP_UNITS_API_CONTRACTS"] = str(opt.contracts).upper()
         tc.cache_variables["MP_UNITS_API_NATURAL_UNITS"] = opt.natural_units
+        tc.cache_variables["MP_UNITS_API_PROFILE_CONVERSIONS"] = opt.profile_conversions
+        tc.cache_variables["MP_UNITS_API_CONVERSION_DIAGNOSTICS"] = opt.conversion_diagnostics
 
         tc.generate()
         deps = CMakeDeps(self)
@@ -350,6 +364,18 @@ class MPUnitsConan(ConanFile):
             if not self.options.freestanding:
                 self.cpp_info.components["core"].defines.append("MP_UNITS_HOSTED=1")
 
+            # handle conversion profiler
+            if self.options.profile_conversions:
+                self.cpp_info.components["core"].defines.append(
+                    "MP_UNITS_API_PROFILE_CONVERSIONS=1"
+                )
+
+            # handle conversion diagnostics
+            if self.options.conversion_diagnostics:
+                self.cpp_info.components["core"].defines.append(
+                    "MP_UNITS_API_CONVERSION_DIAGNOSTICS=1"
+                )
+
             # handle import std
             if self.options.import_std:
                 self.cpp_info.components["core"].defines.append("MP_UNITS_IMPORT_STD")
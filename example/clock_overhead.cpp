@@ -0,0 +1,84 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "fast_clocks.h"
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/si.h>
+#endif
+
+namespace {
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+template<typename T, typename U>
+concept Subtractable = requires(T t, U u) { t - u; };
+
+// time points of different clocks are measured from different absolute point origins
+static_assert(Subtractable<decltype(now<clocks::tsc_clock>()), decltype(now<clocks::tsc_clock>())>);
+static_assert(!Subtractable<decltype(now<clocks::tsc_clock>()), decltype(now<clocks::coarse_steady_clock>())>);
+static_assert(!Subtractable<decltype(now<clocks::tsc_clock>()), decltype(now<std::chrono::steady_clock>())>);
+
+// average cost of reading a clock
+template<typename Clock>
+quantity<ns, double> read_cost()
+{
+  constexpr std::int64_t iterations = 10'000'000;
+  std::int64_t sink = 0;
+  const auto start = now<std::chrono::steady_clock>();
+  for (std::int64_t i = 0; i < iterations; ++i) sink += now<Clock>().quantity_from_zero().numerical_value_in(ns) & 1;
+  const auto elapsed = now<std::chrono::steady_clock>() - start;
+  if (sink < 0) std::cout << sink;
+  return value_cast<double>(elapsed) / static_cast<double>(iterations);
+}
+
+}  // namespace
+
+int main()
+{
+  clocks::tsc_clock::calibrate();
+  std::cout << "Invariant TSC: " << (clocks::tsc_clock::invariant_tsc() ? "yes" : "no") << "\n\n";
+
+  std::cout << "Cost of reading a clock:\n";
+  std::cout << "- steady_clock:        " << read_cost<std::chrono::steady_clock>() << "\n";
+  std::cout << "- tsc_clock:           " << read_cost<clocks::tsc_clock>() << "\n";
+  std::cout << "- coarse_steady_clock: " << read_cost<clocks::coarse_steady_clock>() << "\n\n";
+
+  const auto start = now<clocks::tsc_clock>();
+  const auto coarse_start = now<clocks::coarse_steady_clock>();
+  std::this_thread::sleep_for(std::chrono::milliseconds(15));
+  const quantity elapsed = now<clocks::tsc_clock>() - start;
+  const quantity coarse_elapsed = now<clocks::coarse_steady_clock>() - coarse_start;
+  std::cout << "Sleeping for 15 ms took " << elapsed.in<double>(ms) << " (" << coarse_elapsed.in<double>(ms)
+            << " with a coarse clock)\n";
+}
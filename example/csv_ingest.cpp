@@ -0,0 +1,93 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "csv_reader.h"
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <sstream>
+#include <string>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/isq.h>
+#include <mp-units/systems/si.h>
+#endif
+
+namespace {
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+// an export of a vehicle logger with units in the header cells and a column that is not needed
+std::string make_export(std::size_t rows)
+{
+  std::ostringstream os;
+  os << "time [s],speed [km/h],note,temp (°C)\n";
+  for (std::size_t i = 0; i < rows; ++i)
+    os << i << ',' << 36. + static_cast<double>(i % 100) / 10. << ",ok," << 20. + static_cast<double>(i % 7) << '\n';
+  return os.str();
+}
+
+}  // namespace
+
+int main()
+{
+  using time = quantity<isq::time[s]>;
+  using speed = quantity<isq::speed[m / s]>;
+  using temperature = quantity_point<isq::thermodynamic_temperature[K], si::zeroth_kelvin>;
+
+  std::istringstream is(make_export(100'000));
+
+  // `speed` and `temp` are stored in different units than the ones used in the export
+  csv::reader reader(is, {.threads = 4}, csv::column<time>{"time"},
+                     csv::column<speed, si::kilo<si::metre> / non_si::hour>{"speed"},
+                     csv::column<temperature, si::degree_Celsius>{"temp"});
+  decltype(reader)::batch_type batch(16'384);
+
+  std::size_t rows = 0;
+  quantity<isq::length[m]> distance{};
+  speed max_speed{};
+  temperature max_temp{};
+  while (reader.read(batch) > 0) {
+    const auto times = batch.column<0>();
+    const auto speeds = batch.column<1>();
+    const auto temps = batch.column<2>();
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      if (rows + i > 0) distance += speeds[i] * (1 * s);
+      max_speed = std::max(max_speed, speeds[i]);
+      max_temp = rows + i == 0 ? temps[i] : std::max(max_temp, temps[i]);
+    }
+    rows += batch.size();
+    std::cout << "Read " << rows << " rows, last at " << times.back() << "\n";
+  }
+
+  std::cout << "Distance: " << distance.in(km) << "\n";
+  std::cout << "Max speed: " << max_speed << " (" << max_speed.in(km / h) << ")\n";
+  std::cout << "Max temperature: " << max_temp.quantity_from_zero() << " ("
+            << max_temp.quantity_from(si::ice_point).in(deg_C) << ")\n";
+}
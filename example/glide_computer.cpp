@@ -31,11 +31,13 @@ import std;
 #include <array>
 #include <chrono>
 #include <concepts>
+#include <cstddef>
 #include <exception>
 #include <iostream>
 #include <ranges>
 #include <string>
 #include <utility>
+#include <vector>
 #endif
 #ifdef MP_UNITS_MODULES
 import mp_units;
@@ -161,6 +163,44 @@ void print(const aircraft_tow& tow)
   std::cout << "\n";
 }
 
+// estimates all the combinations of gliders, weather conditions, and safety margins at once
+template<typename Gliders, typename Conditions>
+void plan_competition(timestamp start_time, const Gliders& gliders, const Conditions& conditions, const task& t,
+                      const aircraft_tow& tow)
+{
+  using mp_units::si::unit_symbols::m;
+
+  const std::array margins = {safety{200 * m}, safety{300 * m}, safety{500 * m}};
+  std::vector<scenario> scenarios;
+  for (const auto& g : gliders)
+    for (const auto& c : conditions)
+      for (const auto& s : margins) scenarios.push_back({g, c.second, s, tow});
+
+  const std::vector<flight_estimate> results = estimate(start_time, t, scenarios);
+
+  std::cout << "Competition planning:\n";
+  std::cout << "=====================\n";
+  std::cout << MP_UNITS_STD_FMT::format("| {:<20} | {:<7} | {:^10} | {:^10} | {:^12} |\n", "Glider", "Weather",
+                                        "Min AGL", "Time", "Speed");
+  std::cout << MP_UNITS_STD_FMT::format("|{0:-^22}|{0:-^9}|{0:-^12}|{0:-^12}|{0:-^14}|\n", "");
+  std::size_t i = 0;
+  for (const auto& g : gliders)
+    for (const auto& c : conditions)
+      for (const auto& s : margins) {
+        const flight_estimate& res = results[i++];
+        if (!res.completed) {
+          std::cout << MP_UNITS_STD_FMT::format("| {:<20} | {:<7} | {:>10:N[.0f]} | {:^25} |\n", g.name, c.first,
+                                                s.min_agl_height, "outlanding");
+          continue;
+        }
+        const auto speed = (res.total_distance() / res.total_time()).in(si::kilo<si::metre> / si::hour);
+        std::cout << MP_UNITS_STD_FMT::format("| {:<20} | {:<7} | {:>10:N[.0f]} | {:>10:N[.1f]} | {:>12:N[.1f]} |\n",
+                                              g.name, c.first, s.min_agl_height,
+                                              value_cast<si::minute>(res.total_time()), speed);
+      }
+  std::cout << "\n";
+}
+
 void example()
 {
   using mp_units::si::unit_symbols::m;
@@ -192,6 +232,8 @@ void example()
       std::cout << "\n\n";
     }
   }
+
+  plan_competition(start_time, gliders, weather_conditions, t, tow);
 }
 
 }  // namespace
@@ -21,14 +21,22 @@
 // SOFTWARE.
 
 #include "glide_computer_lib.h"
+#include <mp-units/ext/contracts.h>
 #include <mp-units/ext/format.h>
 #ifdef MP_UNITS_IMPORT_STD
 import std;
 #else
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
 #include <functional>
 #include <iostream>
 #include <numeric>
-#include <string_view>
+#include <span>
+#include <thread>
+#include <vector>
 #endif
 #ifdef MP_UNITS_MODULES
 import mp_units.core;
@@ -60,22 +68,71 @@ std::vector<distance> task::make_leg_total_distances(const legs& legs)
   return res;
 }
 
+void task::set_terrain(geographic::terrain_cache& terrain, distance resolution)
+{
+  MP_UNITS_EXPECTS(resolution > distance::zero());
+  terrain_profiles_.clear();
+  terrain_profiles_.reserve(legs_.size());
+  for (const leg& l : legs_) {
+    const auto intervals = static_cast<std::size_t>(std::ceil((l.get_distance() / resolution).numerical_value_in(one)));
+    auto& profile = terrain_profiles_.emplace_back(std::max<std::size_t>(intervals, 1) + 1);
+    terrain.profile(l.begin().pos, l.end().pos, std::span(profile));
+  }
+}
+
 geographic::msl_altitude terrain_level_alt(const task& t, const flight_point& pos)
 {
   const task::leg& l = t.get_legs()[pos.leg_idx];
-  const height alt_diff = l.end().alt - l.begin().alt;
-  return l.begin().alt + alt_diff * ((pos.dist - t.get_leg_dist_offset(pos.leg_idx)) / l.get_distance());
+  const auto leg_fraction = (pos.dist - t.get_leg_dist_offset(pos.leg_idx)) / l.get_distance();
+  const std::span<const geographic::msl_altitude> profile = t.get_terrain_profile(pos.leg_idx);
+  if (profile.empty()) {
+    const height alt_diff = l.end().alt - l.begin().alt;
+    return l.begin().alt + alt_diff * leg_fraction;
+  }
+
+  const double x = std::clamp(leg_fraction.numerical_value_in(one), 0., 1.) * static_cast<double>(profile.size() - 1);
+  const std::size_t i = std::min(static_cast<std::size_t>(x), profile.size() - 2);
+  return profile[i] + (profile[i + 1] - profile[i]) * (x - static_cast<double>(i));
 }
 
-// Returns `x` of the intersection of a glide line and a terrain line.
+// Without terrain profiles returns `x` of the intersection of a glide line and a terrain line, or zero if
+// the glider is already below the minimum safe altitude.
 // y = -x / glide_ratio + pos.alt;
 // y = (finish_alt - ground_alt) / dist_to_finish * x + ground_alt + min_agl_height;
+// Otherwise, walks the terrain profiles of the remaining legs up to the first sample where the glide line
+// drops below `min_agl_height` and intersects it with the terrain that is linear between the samples.
 distance glide_distance(const flight_point& pos, const glider& g, const task& t, const safety& s,
                         geographic::msl_altitude ground_alt)
 {
   const auto dist_to_finish = t.get_distance() - pos.dist;
-  return quantity_cast<isq::distance>(ground_alt + s.min_agl_height - pos.alt) /
-         ((ground_alt - t.get_finish().alt) / dist_to_finish - 1 / glide_ratio(g.polar[0]));
+  if (t.get_terrain_profile(pos.leg_idx).empty()) {
+    const distance dist = quantity_cast<isq::distance>(ground_alt + s.min_agl_height - pos.alt) /
+                          ((ground_alt - t.get_finish().alt) / dist_to_finish - 1 / glide_ratio(g.polar[0]));
+    return std::max(dist, distance::zero());
+  }
+
+  // height of the glide line above the minimum safe altitude over `ground` at the task distance `d`
+  auto clearance = [&](distance d, geographic::msl_altitude ground) -> height {
+    return pos.alt - quantity_cast<isq::height>((d - pos.dist) / glide_ratio(g.polar[0])) -
+           (ground + s.min_agl_height);
+  };
+  distance prev_dist = pos.dist;
+  height prev_clearance = clearance(pos.dist, ground_alt);
+  if (prev_clearance <= height::zero()) return distance::zero();
+  for (std::size_t leg_idx = pos.leg_idx; leg_idx < t.get_legs().size(); ++leg_idx) {
+    const std::span<const geographic::msl_altitude> profile = t.get_terrain_profile(leg_idx);
+    const distance offset = t.get_leg_dist_offset(leg_idx);
+    const distance step = t.get_legs()[leg_idx].get_distance() / static_cast<double>(profile.size() - 1);
+    for (std::size_t i = 1; i < profile.size(); ++i) {
+      const distance d = offset + step * static_cast<double>(i);
+      if (d <= prev_dist) continue;
+      const height c = clearance(d, profile[i]);
+      if (c <= height::zero()) return prev_dist - pos.dist + (d - prev_dist) * (prev_clearance / (prev_clearance - c));
+      prev_dist = d;
+      prev_clearance = c;
+    }
+  }
+  return dist_to_finish;
 }
 
 }  // namespace glide_computer
@@ -84,83 +141,73 @@ namespace {
 
 using namespace glide_computer;
 
-void print(std::string_view phase_name, timestamp start_ts, const glide_computer::flight_point& point,
-           const glide_computer::flight_point& new_point)
+void print(timestamp start_ts, const flight_phase& phase)
 {
+  constexpr std::array names = {"Tow", "Circle", "Glide", "Final Glide"};
+  const flight_point& point = phase.begin;
+  const flight_point& new_point = phase.end;
   std::cout << MP_UNITS_STD_FMT::format(
     "| {:<12} | {:>9:N[.1]} (Total: {:>9:N[.1]}) | {:>8:N[.1]} (Total: {:>8:N[.1]}) | {:>7:N[.0f]} ({:>6:N[.0f]}) |\n",
-    phase_name, value_cast<si::minute>(new_point.ts - point.ts), value_cast<si::minute>(new_point.ts - start_ts),
-    new_point.dist - point.dist, new_point.dist, new_point.alt - point.alt, new_point.alt);
+    names[static_cast<std::size_t>(phase.type)], value_cast<si::minute>(new_point.ts - point.ts),
+    value_cast<si::minute>(new_point.ts - start_ts), new_point.dist - point.dist, new_point.dist,
+    new_point.alt - point.alt, new_point.alt);
 }
 
 flight_point takeoff(timestamp start_ts, const task& t) { return {start_ts, t.get_start().alt}; }
 
-flight_point tow(timestamp start_ts, const flight_point& pos, const aircraft_tow& at)
+flight_point tow(const flight_point& pos, const aircraft_tow& at)
 {
   const duration d = (at.height_agl / at.performance);
-  const flight_point new_pos{pos.ts + d, pos.alt + at.height_agl, pos.leg_idx, pos.dist};
-
-  print("Tow", start_ts, pos, new_pos);
-  return new_pos;
+  return {pos.ts + d, pos.alt + at.height_agl, pos.leg_idx, pos.dist};
 }
 
-flight_point circle(timestamp start_ts, const flight_point& pos, const glider& g, const weather& w, const task& t,
-                    height& height_to_gain)
+flight_point circle(const flight_point& pos, const glider& g, const weather& w, const task& t, height& height_to_gain)
 {
   const height h_agl = agl(pos.alt, terrain_level_alt(t, pos));
   const height circling_height = std::min(w.cloud_base - h_agl, height_to_gain);
   const rate_of_climb circling_rate = w.thermal_strength + g.polar[0].climb;
   const duration d = (circling_height / circling_rate);
-  const flight_point new_pos{pos.ts + d, pos.alt + circling_height, pos.leg_idx, pos.dist};
-
   height_to_gain -= circling_height;
-
-  print("Circle", start_ts, pos, new_pos);
-  return new_pos;
+  return {pos.ts + d, pos.alt + circling_height, pos.leg_idx, pos.dist};
 }
 
-flight_point glide(timestamp start_ts, const flight_point& pos, const glider& g, const task& t, const safety& s)
+flight_point glide(const flight_point& pos, const glider& g, const task& t, const safety& s)
 {
-  const auto ground_alt = terrain_level_alt(t, pos);
-  const auto dist = glide_distance(pos, g, t, s, ground_alt);
+  const auto dist = glide_distance(pos, g, t, s, terrain_level_alt(t, pos));
   const auto new_distance = pos.dist + dist;
-  const auto alt = ground_alt + s.min_agl_height;
-  const auto l3d = length_3d(dist, pos.alt - alt);
+  const height height_loss = quantity_cast<isq::height>(dist / glide_ratio(g.polar[0]));
+  const auto l3d = length_3d(dist, height_loss);
   const duration d = l3d / g.polar[0].v;
-  const flight_point new_pos{pos.ts + d, terrain_level_alt(t, pos) + s.min_agl_height, t.get_leg_index(new_distance),
-                             new_distance};
-
-  print("Glide", start_ts, pos, new_pos);
-  return new_pos;
+  return {pos.ts + d, pos.alt - height_loss, t.get_leg_index(new_distance), new_distance};
 }
 
-flight_point final_glide(timestamp start_ts, const flight_point& pos, const glider& g, const task& t)
+flight_point final_glide(const flight_point& pos, const glider& g, const task& t)
 {
   const auto dist = t.get_distance() - pos.dist;
   const auto l3d = length_3d(dist, pos.alt - t.get_finish().alt);
   const duration d = l3d / g.polar[0].v;
-  const flight_point new_pos{pos.ts + d, t.get_finish().alt, t.get_legs().size() - 1, pos.dist + dist};
-
-  print("Final Glide", start_ts, pos, new_pos);
-  return new_pos;
+  return {pos.ts + d, t.get_finish().alt, t.get_legs().size() - 1, pos.dist + dist};
 }
 
 }  // namespace
 
 namespace glide_computer {
 
-void estimate(timestamp start_ts, const glider& g, const weather& w, const task& t, const safety& s,
-              const aircraft_tow& at)
+flight_estimate estimate(timestamp start_ts, const task& t, const scenario& sc)
 {
-  std::cout << MP_UNITS_STD_FMT::format("| {:<12} | {:^28} | {:^26} | {:^21} |\n", "Flight phase", "Duration",
-                                        "Distance", "Height");
-  std::cout << MP_UNITS_STD_FMT::format("|{0:-^14}|{0:-^30}|{0:-^28}|{0:-^23}|\n", "");
+  const glider& g = sc.g;
+  const weather& w = sc.w;
+  flight_estimate res;
+  auto add_phase = [&](flight_phase::kind type, const flight_point& from, const flight_point& to) {
+    res.phases.push_back({type, from, to});
+    return to;
+  };
 
   // ready to takeoff
   flight_point pos = takeoff(start_ts, t);
 
   // estimate aircraft towing
-  pos = tow(start_ts, pos, at);
+  pos = add_phase(flight_phase::kind::tow, pos, tow(pos, sc.at));
 
   // estimate the msl_altitude needed to reach the finish line from this place
   const geographic::msl_altitude final_glide_alt =
@@ -171,14 +218,51 @@ void estimate(timestamp start_ts, const glider& g, const weather& w, const task&
 
   do {
     // glide to the next thermall
-    pos = glide(start_ts, pos, g, t, s);
+    pos = add_phase(flight_phase::kind::glide, pos, glide(pos, g, t, sc.s));
+
+    // the glider cannot climb in thermals weaker than its sink rate or below the cloud base
+    if (w.thermal_strength + g.polar[0].climb <= rate_of_climb::zero() ||
+        w.cloud_base - agl(pos.alt, terrain_level_alt(t, pos)) <= height::zero()) {
+      res.completed = false;
+      return res;
+    }
 
     // circle in a thermall to gain height
-    pos = circle(start_ts, pos, g, w, t, height_to_gain);
+    pos = add_phase(flight_phase::kind::circle, pos, circle(pos, g, w, t, height_to_gain));
   } while (height_to_gain > height{});
 
   // final glide
-  pos = final_glide(start_ts, pos, g, t);
+  add_phase(flight_phase::kind::final_glide, pos, final_glide(pos, g, t));
+  return res;
+}
+
+std::vector<flight_estimate> estimate(timestamp start_ts, const task& t, std::span<const scenario> scenarios,
+                                      unsigned threads)
+{
+  std::vector<flight_estimate> res(scenarios.size());
+  // the scenarios differ a lot in the number of phases, so the idle workers take the next scenario
+  // from a shared counter instead of processing fixed chunks
+  std::atomic<std::size_t> next = 0;
+  const std::size_t workers = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(scenarios.size(), 1));
+  std::vector<std::jthread> pool;
+  pool.reserve(workers);
+  for (std::size_t w = 0; w < workers; ++w)
+    pool.emplace_back([&] {
+      for (std::size_t i = next++; i < scenarios.size(); i = next++) res[i] = estimate(start_ts, t, scenarios[i]);
+    });
+  pool.clear();
+  return res;
+}
+
+void estimate(timestamp start_ts, const glider& g, const weather& w, const task& t, const safety& s,
+              const aircraft_tow& at)
+{
+  std::cout << MP_UNITS_STD_FMT::format("| {:<12} | {:^28} | {:^26} | {:^21} |\n", "Flight phase", "Duration",
+                                        "Distance", "Height");
+  std::cout << MP_UNITS_STD_FMT::format("|{0:-^14}|{0:-^30}|{0:-^28}|{0:-^23}|\n", "");
+
+  const flight_estimate res = estimate(start_ts, t, scenario{g, w, s, at});
+  for (const flight_phase& phase : res.phases) print(start_ts, phase);
 }
 
 }  // namespace glide_computer
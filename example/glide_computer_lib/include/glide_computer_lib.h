@@ -25,6 +25,7 @@
 #include <mp-units/compat_macros.h>
 //
 #include "geographic.h"
+#include "terrain.h"
 #ifdef MP_UNITS_IMPORT_STD
 import std;
 #else
@@ -33,10 +34,13 @@ import std;
 #include <chrono>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <initializer_list>
 #include <iterator>
 #include <ranges>
+#include <span>
 #include <string>  // IWYU pragma: keep
+#include <thread>
 #include <vector>
 #endif
 #ifdef MP_UNITS_MODULES
@@ -57,7 +61,7 @@ import mp_units;
 // - constant thermals strength
 // - thermals exactly where and when we need them ;-)
 // - no airspaces
-// - ground level changes linearly between waypoints
+// - ground level changes linearly between waypoints (unless a terrain grid is provided)
 // - no ground obstacles (e.g. mountains) to pass
 // - flight path exactly on a shortest possible line to destination
 
@@ -149,11 +153,26 @@ public:
       std::ranges::distance(leg_total_distances_.cbegin(), std::ranges::lower_bound(leg_total_distances_, dist)));
   }
 
+  /**
+   * @brief Samples the terrain elevation along every leg with at least the given resolution
+   *
+   * Afterwards, `terrain_level_alt()` interpolates those profiles instead of assuming that the ground
+   * level changes linearly between the waypoints.
+   */
+  void set_terrain(geographic::terrain_cache& terrain, distance resolution);
+
+  [[nodiscard]] std::span<const geographic::msl_altitude> get_terrain_profile(std::size_t leg_index) const
+  {
+    if (leg_index >= terrain_profiles_.size()) return {};
+    return terrain_profiles_[leg_index];
+  }
+
 private:
   waypoints waypoints_;
   legs legs_ = make_legs(waypoints_);
   std::vector<distance> leg_total_distances_ = make_leg_total_distances(legs_);
   distance length_ = leg_total_distances_.back();
+  std::vector<std::vector<geographic::msl_altitude>> terrain_profiles_;
 
   static legs make_legs(const task::waypoints& wpts);
   static std::vector<distance> make_leg_total_distances(const legs& legs);
@@ -191,6 +210,48 @@ inline mp_units::quantity<mp_units::isq::length[mp_units::si::kilo<mp_units::si:
 distance glide_distance(const flight_point& pos, const glider& g, const task& t, const safety& s,
                         geographic::msl_altitude ground_alt);
 
+struct scenario {
+  const glider& g;
+  const weather& w;
+  const safety& s;
+  const aircraft_tow& at;
+};
+
+struct flight_phase {
+  enum class kind : std::uint8_t { tow, circle, glide, final_glide };
+  kind type;
+  flight_point begin;
+  flight_point end;
+};
+
+struct flight_estimate {
+  std::vector<flight_phase> phases;
+  bool completed = true;  // `false` if the glider could not gain the height needed to reach the finish
+
+  [[nodiscard]] duration total_time() const
+  {
+    return phases.empty() ? duration::zero() : phases.back().end.ts - phases.front().begin.ts;
+  }
+  [[nodiscard]] distance total_distance() const { return phases.empty() ? distance::zero() : phases.back().end.dist; }
+};
+
+/**
+ * @brief Estimates the flight of a single scenario over the task
+ */
+flight_estimate estimate(timestamp start_ts, const task& t, const scenario& sc);
+
+/**
+ * @brief Estimates the flights of many scenarios over the same task on `threads` worker threads
+ *
+ * The legs of the task and their total distances are computed once in the constructor of `task` and shared
+ * by all the scenarios. The results are returned in the order of `scenarios`.
+ */
+std::vector<flight_estimate> estimate(timestamp start_ts, const task& t, std::span<const scenario> scenarios,
+                                      unsigned threads = std::thread::hardware_concurrency());
+
+/**
+ * @brief Estimates the flight of a single scenario and prints its phases
+ */
 void estimate(timestamp start_ts, const glider& g, const weather& w, const task& t, const safety& s,
               const aircraft_tow& at);
 
@@ -0,0 +1,430 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/contracts.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/framework.h>
+#include <mp-units/systems/isq/base_quantities.h>
+#endif
+
+// An in-memory time series compressed in the way described in "Gorilla: A Fast, Scalable, In-Memory Time
+// Series Database" (Pelkonen et al., VLDB 2015)
+//
+// The samples are kept in a single bit stream split into blocks of a fixed number of samples. The first
+// sample of a block is stored verbatim. For the other ones:
+// - the timestamp is stored as the zig-zag encoded delta-of-delta in a 1, 9, 12, 16, or 68-bit code,
+// - a floating-point value is stored as the XOR with the previous value that reuses the previous window of
+//   meaningful bits when possible,
+// - an integral value is stored as the zig-zag encoded delta in the same variable-length code as the
+//   timestamps.
+//
+// For the regularly sampled and slowly changing signals, that gives 1 or 2 bits per timestamp and a few
+// bits per value. Only the numerical values are stored; the references and the point origins of both the
+// timestamps and the values are fixed at compile time by the template parameters.
+
+namespace time_series {
+
+namespace detail {
+
+template<typename T>
+[[nodiscard]] constexpr const typename T::rep& numerical_value(const T& v)
+{
+  if constexpr (mp_units::QuantityPoint<T>)
+    return v.quantity_ref_from(T::point_origin).numerical_value_ref_in(T::unit);
+  else
+    return v.numerical_value_ref_in(T::unit);
+}
+
+template<typename T>
+[[nodiscard]] constexpr T make(typename T::rep value)
+{
+  if constexpr (mp_units::QuantityPoint<T>)
+    return T{typename T::quantity_type{value, T::reference}, T::point_origin};
+  else
+    return T{value, T::reference};
+}
+
+[[nodiscard]] constexpr std::uint64_t zig_zag(std::uint64_t v) { return (v << 1) ^ (0 - (v >> 63)); }
+[[nodiscard]] constexpr std::uint64_t un_zig_zag(std::uint64_t v) { return (v >> 1) ^ (0 - (v & 1)); }
+
+template<typename Rep>
+using bits_t = std::conditional_t<sizeof(Rep) <= 4, std::uint32_t, std::uint64_t>;
+
+template<typename Rep>
+[[nodiscard]] constexpr std::uint64_t to_bits(Rep v)
+{
+  if constexpr (std::floating_point<Rep>)
+    return std::bit_cast<bits_t<Rep>>(v);
+  else
+    return static_cast<std::uint64_t>(v);
+}
+
+template<typename Rep>
+[[nodiscard]] constexpr Rep from_bits(std::uint64_t v)
+{
+  if constexpr (std::floating_point<Rep>)
+    return std::bit_cast<Rep>(static_cast<bits_t<Rep>>(v));
+  else
+    return static_cast<Rep>(v);
+}
+
+class bit_writer {
+public:
+  void write(std::uint64_t value, unsigned count)
+  {
+    if (count == 0) return;
+    if (count < 64) value &= (std::uint64_t{1} << count) - 1;
+    const auto offset = static_cast<unsigned>(size_ % 64);
+    if (offset == 0) words_.push_back(0);
+    words_.back() |= value << offset;
+    if (offset + count > 64) words_.push_back(value >> (64 - offset));
+    size_ += count;
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+  [[nodiscard]] const std::vector<std::uint64_t>& words() const noexcept { return words_; }
+  void shrink_to_fit() { words_.shrink_to_fit(); }
+
+private:
+  std::vector<std::uint64_t> words_;
+  std::size_t size_ = 0;
+};
+
+class bit_reader {
+public:
+  bit_reader(const std::uint64_t* words, std::size_t pos) : words_(words), pos_(pos) {}
+
+  [[nodiscard]] std::uint64_t read(unsigned count)
+  {
+    if (count == 0) return 0;
+    const std::size_t index = pos_ / 64;
+    const auto offset = static_cast<unsigned>(pos_ % 64);
+    std::uint64_t value = words_[index] >> offset;
+    if (offset + count > 64) value |= words_[index + 1] << (64 - offset);
+    if (count < 64) value &= (std::uint64_t{1} << count) - 1;
+    pos_ += count;
+    return value;
+  }
+
+  [[nodiscard]] bool read_bit() { return read(1) != 0; }
+  [[nodiscard]] std::size_t position() const noexcept { return pos_; }
+
+private:
+  const std::uint64_t* words_;
+  std::size_t pos_;
+};
+
+// variable-length code of a zig-zag encoded integer
+inline void write_varint(bit_writer& out, std::uint64_t z)
+{
+  if (z == 0)
+    out.write(0b0, 1);
+  else if (z < (1u << 7))
+    out.write(0b01 | z << 2, 9);
+  else if (z < (1u << 9))
+    out.write(0b011 | z << 3, 12);
+  else if (z < (1u << 12))
+    out.write(0b0111 | z << 4, 16);
+  else {
+    out.write(0b1111, 4);
+    out.write(z, 64);
+  }
+}
+
+[[nodiscard]] inline std::uint64_t read_varint(bit_reader& in)
+{
+  if (!in.read_bit()) return 0;
+  if (!in.read_bit()) return in.read(7);
+  if (!in.read_bit()) return in.read(9);
+  if (!in.read_bit()) return in.read(12);
+  return in.read(64);
+}
+
+// state shared by the encoder and the decoder
+template<typename TimeRep, typename ValueRep>
+struct codec {
+  static constexpr unsigned value_width = std::floating_point<ValueRep> ? sizeof(bits_t<ValueRep>) * 8 : 64;
+
+  std::uint64_t time = 0;
+  std::uint64_t delta = 0;
+  std::uint64_t value = 0;
+  unsigned leading = 0;
+  unsigned trailing = 0;
+  bool window = false;
+
+  void encode_first(bit_writer& out, TimeRep t, ValueRep v)
+  {
+    *this = {to_bits(t), 0, to_bits(v)};
+    out.write(time, 64);
+    out.write(value, value_width);
+  }
+
+  void decode_first(bit_reader& in)
+  {
+    *this = {in.read(64), 0};
+    value = in.read(value_width);
+  }
+
+  void encode(bit_writer& out, TimeRep t, ValueRep v)
+  {
+    const std::uint64_t d = to_bits(t) - time;
+    write_varint(out, zig_zag(d - delta));
+    time += d;
+    delta = d;
+
+    const std::uint64_t bits = to_bits(v);
+    if constexpr (std::floating_point<ValueRep>) {
+      const std::uint64_t x = bits ^ value;
+      value = bits;
+      if (x == 0) {
+        out.write(0b0, 1);
+        return;
+      }
+      const unsigned lead = std::min(static_cast<unsigned>(std::countl_zero(x)) - (64 - value_width), 31u);
+      const auto trail = static_cast<unsigned>(std::countr_zero(x));
+      if (window && lead >= leading && trail >= trailing) {
+        out.write(0b01, 2);
+        out.write(x >> trailing, value_width - leading - trailing);
+        return;
+      }
+      window = true;
+      leading = lead;
+      trailing = trail;
+      const unsigned length = value_width - lead - trail;
+      out.write(0b11 | lead << 2 | (length - 1) << 7, 13);
+      out.write(x >> trail, length);
+    } else {
+      write_varint(out, zig_zag(bits - value));
+      value = bits;
+    }
+  }
+
+  void decode(bit_reader& in)
+  {
+    delta += un_zig_zag(read_varint(in));
+    time += delta;
+
+    if constexpr (std::floating_point<ValueRep>) {
+      if (!in.read_bit()) return;
+      if (in.read_bit()) {
+        window = true;
+        leading = static_cast<unsigned>(in.read(5));
+        const unsigned length = static_cast<unsigned>(in.read(6)) + 1;
+        trailing = value_width - leading - length;
+      }
+      value ^= in.read(value_width - leading - trailing) << trailing;
+    } else {
+      value += un_zig_zag(read_varint(in));
+    }
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief A compressed time series of values measured at given time points
+ *
+ * The samples have to be appended in the order of non-decreasing timestamps. The numerical values of the
+ * timestamps have to be integral and the ones of the values either integral or IEEE 754 binary32/binary64.
+ *
+ * @tparam Time quantity point of time
+ * @tparam Value quantity or quantity point type of the values
+ */
+template<mp_units::QuantityPointOf<mp_units::isq::time> Time, typename Value>
+  requires std::integral<typename Time::rep> && (mp_units::Quantity<Value> || mp_units::QuantityPoint<Value>) &&
+           (std::integral<typename Value::rep> ||
+            (std::floating_point<typename Value::rep> && std::numeric_limits<typename Value::rep>::is_iec559 &&
+             (sizeof(typename Value::rep) == 4 || sizeof(typename Value::rep) == 8)))
+class compressed_series {
+  using time_rep = Time::rep;
+  using value_rep = Value::rep;
+  using codec = detail::codec<time_rep, value_rep>;
+
+public:
+  struct sample {
+    Time time;
+    Value value;
+  };
+
+  /**
+   * @brief A forward iterator decoding the samples
+   *
+   * Appending to the series does not invalidate the iterators.
+   */
+  class iterator {
+  public:
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = sample;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+
+    [[nodiscard]] sample operator*() const
+    {
+      return {detail::make<Time>(detail::from_bits<time_rep>(codec_.time)),
+              detail::make<Value>(detail::from_bits<value_rep>(codec_.value))};
+    }
+
+    iterator& operator++()
+    {
+      if (++index_ < series_->size_) {
+        if (index_ % series_->block_size_ == 0) {
+          pos_ = series_->blocks_[index_ / series_->block_size_];
+          decode(&codec::decode_first);
+        } else
+          decode(&codec::decode);
+      }
+      return *this;
+    }
+
+    iterator operator++(int)
+    {
+      iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    [[nodiscard]] friend bool operator==(const iterator& lhs, const iterator& rhs) { return lhs.index_ == rhs.index_; }
+    [[nodiscard]] friend bool operator==(const iterator& it, std::default_sentinel_t)
+    {
+      return it.index_ >= it.series_->size();
+    }
+
+  private:
+    friend class compressed_series;
+
+    const compressed_series* series_ = nullptr;
+    std::size_t index_ = 0;
+    std::size_t pos_ = 0;
+    codec codec_{};
+
+    // starts decoding at the beginning of a block
+    iterator(const compressed_series& series, std::size_t block) :
+        series_(&series), index_(block * series.block_size_)
+    {
+      if (index_ < series_->size_) {
+        pos_ = series_->blocks_[block];
+        decode(&codec::decode_first);
+      }
+    }
+
+    void decode(void (codec::*f)(detail::bit_reader&))
+    {
+      detail::bit_reader in(series_->bits_.words().data(), pos_);
+      (codec_.*f)(in);
+      pos_ = in.position();
+    }
+  };
+
+  explicit compressed_series(std::size_t block_size = 4096) : block_size_(block_size)
+  {
+    MP_UNITS_EXPECTS(block_size > 0);
+  }
+
+  /**
+   * @brief Appends a sample in O(1) amortized time
+   */
+  void push_back(Time time, Value value)
+  {
+    const time_rep t = detail::numerical_value(time);
+    const value_rep v = detail::numerical_value(value);
+    if (size_ % block_size_ == 0) {
+      MP_UNITS_EXPECTS(size_ == 0 || t >= last_time_);
+      blocks_.push_back(bits_.size());
+      first_times_.push_back(t);
+      codec_.encode_first(bits_, t, v);
+    } else {
+      MP_UNITS_EXPECTS(t >= last_time_);
+      codec_.encode(bits_, t, v);
+    }
+    last_time_ = t;
+    ++size_;
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+  /**
+   * @brief Number of bytes of the memory used by the samples and the block index
+   */
+  [[nodiscard]] std::size_t memory_usage() const noexcept
+  {
+    return bits_.words().capacity() * sizeof(std::uint64_t) + blocks_.capacity() * sizeof(std::size_t) +
+           first_times_.capacity() * sizeof(time_rep);
+  }
+
+  void shrink_to_fit()
+  {
+    bits_.shrink_to_fit();
+    blocks_.shrink_to_fit();
+    first_times_.shrink_to_fit();
+  }
+
+  [[nodiscard]] iterator begin() const { return iterator(*this, 0); }
+  [[nodiscard]] std::default_sentinel_t end() const { return {}; }
+
+  /**
+   * @brief Returns an iterator to the first sample not earlier than `time`
+   *
+   * Only the block containing that sample is decoded.
+   */
+  [[nodiscard]] iterator lower_bound(Time time) const
+  {
+    const time_rep t = detail::numerical_value(time);
+    // the last block starting before `t` may still contain samples not earlier than `t`
+    const auto first = std::ranges::lower_bound(first_times_, t);
+    const auto block = static_cast<std::size_t>(std::max(first - first_times_.begin(), std::ptrdiff_t{1}) - 1);
+    iterator it(*this, block);
+    while (it != end() && detail::numerical_value((*it).time) < t) ++it;
+    return it;
+  }
+
+private:
+  std::size_t block_size_;
+  std::size_t size_ = 0;
+  time_rep last_time_{};
+  detail::bit_writer bits_;
+  std::vector<std::size_t> blocks_;  // position of the first bit of every block
+  std::vector<time_rep> first_times_;
+  codec codec_{};
+};
+
+}  // namespace time_series
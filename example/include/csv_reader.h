@@ -0,0 +1,452 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <istream>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/framework.h>
+#endif
+
+// A streaming reader of CSV/TSV files with a unit in every header cell
+//
+// Header cells provide the name of a column and its unit in brackets or parentheses
+// (e.g. `speed [km/h]` or `temp (°C)`). The unit is matched once against the symbols of the units
+// accepted for a column and the linear transformation of the numerical values from that unit to the
+// unit of the column type is precomputed. The rows are then parsed with `std::from_chars` straight
+// into the preallocated column buffers of a `csv::batch`.
+//
+// The input is read through a fixed-size buffer, so the memory use does not depend on the size of the
+// file, and the complete lines in the buffer may be parsed on several threads. No memory is allocated
+// per row. Quoted fields are not supported.
+
+namespace csv {
+
+/**
+ * @brief Description of a column to be read
+ *
+ * @tparam T quantity or quantity point type of the values
+ * @tparam Units other units accepted in the header besides the unit of `T`
+ */
+template<typename T, mp_units::Unit auto... Units>
+  requires mp_units::Quantity<T> || mp_units::QuantityPoint<T>
+struct column {
+  using value_type = T;
+  std::string_view name;
+};
+
+template<typename T>
+concept Column = requires(const T& c) {
+  typename T::value_type;
+  { c.name } -> std::convertible_to<std::string_view>;
+};
+
+template<Column... Columns>
+class reader;
+
+/**
+ * @brief Column buffers of a fixed number of rows
+ */
+template<typename... Ts>
+class batch {
+public:
+  explicit batch(std::size_t capacity) : columns_(std::vector<Ts>(capacity)...), capacity_(capacity) {}
+
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+  [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+  template<std::size_t I>
+  [[nodiscard]] auto column() const
+  {
+    return std::span(std::get<I>(columns_)).first(size_);
+  }
+
+private:
+  template<Column... Columns>
+  friend class reader;
+
+  std::tuple<std::vector<Ts>...> columns_;
+  std::size_t capacity_;
+  std::size_t size_ = 0;
+};
+
+struct options {
+  char delimiter = 0;  ///< `0` detects a tab or a comma from the header
+  unsigned threads = 1;
+  std::size_t buffer_size = std::size_t{1} << 20;
+};
+
+namespace detail {
+
+[[nodiscard]] constexpr std::string_view trim(std::string_view text)
+{
+  constexpr std::string_view blanks = " \t\r\"";
+  const auto first = text.find_first_not_of(blanks);
+  if (first == std::string_view::npos) return {};
+  return text.substr(first, text.find_last_not_of(blanks) - first + 1);
+}
+
+struct header_cell {
+  std::string_view name;
+  std::string_view unit;
+};
+
+// splits `speed [km/h]` or `temp (°C)` into the name and the unit
+[[nodiscard]] constexpr header_cell parse_header_cell(std::string_view cell)
+{
+  cell = trim(cell);
+  for (const auto& [open, close] : {std::pair{'[', ']'}, std::pair{'(', ')'}})
+    if (cell.ends_with(close))
+      if (const auto pos = cell.rfind(open); pos != std::string_view::npos)
+        return {trim(cell.substr(0, pos)), trim(cell.substr(pos + 1, cell.size() - pos - 2))};
+  return {cell, {}};
+}
+
+// compares the unit in a header with a unit symbol accepting the common spellings of the degree units
+[[nodiscard]] constexpr bool symbol_matches(std::string_view text, std::string_view symbol)
+{
+  if (text == symbol) return true;
+  constexpr std::array<std::pair<std::string_view, std::string_view>, 2> spellings = {
+    {{"℃", "°C"}, {"℉", "°F"}}};
+  for (const auto& [from, to] : spellings)
+    if (symbol.starts_with(from) && text.starts_with(to) && text.substr(to.size()) == symbol.substr(from.size()))
+      return true;
+  return false;
+}
+
+// a numerical value in the unit of a header is converted as `value * factor + offset`
+struct transform {
+  double factor = 1;
+  double offset = 0;
+  [[nodiscard]] bool identity() const { return factor == 1 && offset == 0; }
+};
+
+template<typename T, mp_units::Unit auto U>
+[[nodiscard]] transform make_transform()
+{
+  using namespace mp_units;
+  using target = quantity<T::reference, double>;
+  transform res{target(delta<U>(1.)).numerical_value_in(T::unit), 0};
+  if constexpr (QuantityPoint<T>) {
+    using target_point = quantity_point<T::reference, T::point_origin, double>;
+    // values in offset units (e.g. degrees Celsius) are measured from their own origins
+    if constexpr (std::convertible_to<decltype(point<U>(0.)), target_point>)
+      res.offset = target_point(point<U>(0.)).quantity_from(T::point_origin).numerical_value_in(T::unit);
+  }
+  return res;
+}
+
+template<typename T, mp_units::Unit auto... Us>
+[[nodiscard]] transform find_transform(std::string_view name, std::string_view unit)
+{
+  using namespace mp_units;
+  constexpr unit_symbol_formatting portable{.char_set = character_set::portable};
+  transform res;
+  const bool found = (((symbol_matches(unit, unit_symbol(Us)) || symbol_matches(unit, unit_symbol<portable>(Us))) &&
+                       (res = make_transform<T, Us>(), true)) ||
+                      ...);
+  if (!found)
+    throw std::invalid_argument("unsupported unit '" + std::string(unit) + "' of column '" + std::string(name) + "'");
+  return res;
+}
+
+template<typename T, mp_units::Unit auto... Units>
+[[nodiscard]] transform column_transform(const column<T, Units...>& c, std::string_view unit)
+{
+  return find_transform<T, T::unit, Units...>(c.name, unit);
+}
+
+template<typename T>
+[[nodiscard]] T make_value(typename T::rep value)
+{
+  if constexpr (mp_units::QuantityPoint<T>)
+    return T{typename T::quantity_type{value, T::reference}, T::point_origin};
+  else
+    return T{value, T::reference};
+}
+
+template<typename T>
+[[nodiscard]] T parse_value(std::string_view field, const transform& t)
+{
+  using rep = T::rep;
+  field = trim(field);
+  if (field.starts_with('+')) field.remove_prefix(1);
+  if (field.empty()) {
+    // a missing value is stored as NaN if possible
+    if constexpr (std::numeric_limits<rep>::has_quiet_NaN)
+      return make_value<T>(std::numeric_limits<rep>::quiet_NaN());
+    else
+      throw std::invalid_argument("missing value of an integral column");
+  }
+  const auto parse = [&]<typename V>(V& value) {
+    const auto [ptr, ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+    if (ec != std::errc{} || ptr != field.data() + field.size())
+      throw std::invalid_argument("invalid number '" + std::string(field) + "'");
+  };
+  if (t.identity()) {
+    rep value{};
+    parse(value);
+    return make_value<T>(value);
+  }
+  double value{};
+  parse(value);
+  const double converted = value * t.factor + t.offset;
+  if constexpr (std::is_integral_v<rep>) {
+    // like the library, do not truncate the values silently; only the rounding errors of the factor are accepted
+    const double rounded = std::round(converted);
+    const double limit = std::ldexp(1., std::numeric_limits<rep>::digits);
+    if (!(std::abs(converted - rounded) <= 1e-9 * std::max(1., std::abs(rounded))) || rounded >= limit ||
+        rounded < (std::is_signed_v<rep> ? -limit : 0.))
+      throw std::invalid_argument("value '" + std::string(field) + "' is not representable in the column type");
+    return make_value<T>(static_cast<rep>(rounded));
+  } else
+    return make_value<T>(static_cast<rep>(converted));
+}
+
+}  // namespace detail
+
+/**
+ * @brief Reads the columns described by `Columns` from a CSV/TSV stream
+ *
+ * The columns are found by their names in the header. Other columns of the stream are skipped.
+ *
+ * Empty fields are read as NaN into floating-point columns. Integral columns reject empty fields and the
+ * values that can't be converted to their unit exactly (e.g. `1500 ms` read into whole seconds).
+ *
+ * @throws std::invalid_argument if a column is missing, its unit is not accepted, a line is longer than the
+ *         buffer, or a value is not a number or is not representable in the column type
+ */
+template<Column... Columns>
+class reader {
+public:
+  using batch_type = batch<typename Columns::value_type...>;
+
+  explicit reader(std::istream& is, const Columns&... columns) : reader(is, options{}, columns...) {}
+
+  reader(std::istream& is, options opts, const Columns&... columns) :
+      is_(is), opts_(opts), buffer_(std::max<std::size_t>(opts.buffer_size, 2))
+  {
+    opts_.threads = std::max(opts_.threads, 1u);
+    std::string_view header = next_line();
+    if (header.starts_with("\xEF\xBB\xBF")) header.remove_prefix(3);
+    if (opts_.delimiter == 0) opts_.delimiter = header.find('\t') != std::string_view::npos ? '\t' : ',';
+
+    std::vector<detail::header_cell> cells;
+    for_each_field(header,
+                   [&](std::size_t, std::string_view cell) { cells.push_back(detail::parse_header_cell(cell)); });
+    slots_.assign(cells.size(), no_slot);
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      (bind(Is, columns, cells), ...);
+    }(std::index_sequence_for<Columns...>{});
+  }
+
+  /**
+   * @brief Replaces the contents of `out` with the next rows of the stream
+   *
+   * @return number of the rows read; `0` at the end of the stream
+   */
+  std::size_t read(batch_type& out)
+  {
+    out.size_ = 0;
+    while (out.size_ < out.capacity()) {
+      collect_lines(out.capacity() - out.size_);
+      if (lines_.empty()) {
+        if (eof_) {
+          // the last line does not have to end with a newline
+          if (begin_ < end_) add_line(std::exchange(begin_, end_), end_);
+          if (lines_.empty()) break;
+        } else {
+          refill();
+          continue;
+        }
+      }
+      parse(out);
+      out.size_ += lines_.size();
+    }
+    return out.size_;
+  }
+
+private:
+  static constexpr std::size_t no_slot = std::numeric_limits<std::size_t>::max();
+
+  std::istream& is_;
+  options opts_;
+  std::vector<char> buffer_;
+  std::size_t begin_ = 0;
+  std::size_t end_ = 0;
+  bool eof_ = false;
+  std::vector<std::size_t> slots_;  // index of the column read from every field
+  std::size_t last_field_ = 0;
+  std::array<detail::transform, sizeof...(Columns)> transforms_;
+  std::vector<std::pair<std::size_t, std::size_t>> lines_;
+  std::vector<std::exception_ptr> errors_;
+
+  template<typename Column>
+  void bind(std::size_t index, const Column& c, std::span<const detail::header_cell> cells)
+  {
+    const auto it = std::ranges::find(cells, c.name, &detail::header_cell::name);
+    if (it == cells.end()) throw std::invalid_argument("missing column '" + std::string(c.name) + "'");
+    const auto field = static_cast<std::size_t>(it - cells.begin());
+    slots_[field] = index;
+    last_field_ = std::max(last_field_, field);
+    transforms_[index] = detail::column_transform(c, it->unit);
+  }
+
+  // moves the unread bytes to the front of the buffer and fills the rest of it from the stream
+  void refill()
+  {
+    if (begin_ == 0 && end_ == buffer_.size()) throw std::invalid_argument("line longer than the buffer");
+    std::copy(buffer_.data() + begin_, buffer_.data() + end_, buffer_.data());
+    end_ -= begin_;
+    begin_ = 0;
+    is_.read(buffer_.data() + end_, static_cast<std::streamsize>(buffer_.size() - end_));
+    const auto count = static_cast<std::size_t>(is_.gcount());
+    end_ += count;
+    eof_ = count == 0;
+  }
+
+  [[nodiscard]] std::string_view next_line()
+  {
+    while (true) {
+      const char* const first = buffer_.data() + begin_;
+      const char* const last = buffer_.data() + end_;
+      const char* const nl = std::find(first, last, '\n');
+      if (nl != last || eof_) {
+        begin_ = static_cast<std::size_t>(std::min(nl + 1, last) - buffer_.data());
+        return {first, nl};
+      }
+      refill();
+    }
+  }
+
+  void add_line(std::size_t first, std::size_t last)
+  {
+    if (last > first && buffer_[last - 1] == '\r') --last;
+    if (last > first) lines_.emplace_back(first, last);
+  }
+
+  // finds at most `max` complete non-empty lines in the buffer
+  void collect_lines(std::size_t max)
+  {
+    lines_.clear();
+    const char* const last = buffer_.data() + end_;
+    while (lines_.size() < max) {
+      const char* const first = buffer_.data() + begin_;
+      const char* const nl = std::find(first, last, '\n');
+      if (nl == last) break;
+      add_line(begin_, static_cast<std::size_t>(nl - buffer_.data()));
+      begin_ = static_cast<std::size_t>(nl - buffer_.data()) + 1;
+    }
+  }
+
+  template<typename F>
+  std::size_t for_each_field(std::string_view line, F&& f) const
+  {
+    std::size_t field = 0;
+    while (true) {
+      const auto pos = line.find(opts_.delimiter);
+      f(field++, line.substr(0, pos));
+      if (pos == std::string_view::npos) return field;
+      line.remove_prefix(pos + 1);
+    }
+  }
+
+  void parse_line(std::string_view line, batch_type& out, std::size_t row) const
+  {
+    const std::size_t fields = for_each_field(line, [&](std::size_t field, std::string_view text) {
+      if (field >= slots_.size() || slots_[field] == no_slot) return;
+      [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        ((slots_[field] == Is && (store<Is>(out, row, text), true)) || ...);
+      }(std::index_sequence_for<Columns...>{});
+    });
+    if (fields <= last_field_) throw std::invalid_argument("missing values in line '" + std::string(line) + "'");
+  }
+
+  template<std::size_t I>
+  void store(batch_type& out, std::size_t row, std::string_view text) const
+  {
+    auto& values = std::get<I>(out.columns_);
+    using value_type = std::ranges::range_value_t<decltype(values)>;
+    values[row] = detail::parse_value<value_type>(text, transforms_[I]);
+  }
+
+  // parses the collected lines into `out` starting at its current size, on several threads for larger batches
+  void parse(batch_type& out)
+  {
+    constexpr std::size_t min_lines_per_thread = 1024;
+    const std::size_t workers = std::clamp<std::size_t>(lines_.size() / min_lines_per_thread, 1, opts_.threads);
+    const auto parse_range = [&](std::size_t first, std::size_t last) {
+      for (std::size_t i = first; i < last; ++i) {
+        const auto [begin, end] = lines_[i];
+        parse_line({buffer_.data() + begin, end - begin}, out, out.size_ + i);
+      }
+    };
+    if (workers == 1) {
+      parse_range(0, lines_.size());
+      return;
+    }
+
+    errors_.assign(workers, nullptr);
+    const std::size_t chunk = (lines_.size() + workers - 1) / workers;
+    {
+      std::vector<std::jthread> pool;
+      pool.reserve(workers);
+      for (std::size_t w = 0; w < workers; ++w)
+        pool.emplace_back([&, w] {
+          try {
+            parse_range(w * chunk, std::min((w + 1) * chunk, lines_.size()));
+          } catch (...) {
+            errors_[w] = std::current_exception();
+          }
+        });
+    }
+    for (const std::exception_ptr& e : errors_)
+      if (e) std::rethrow_exception(e);
+  }
+};
+
+}  // namespace csv
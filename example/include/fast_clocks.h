@@ -0,0 +1,180 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#endif
+#if defined(__linux__)
+#include <time.h>
+#endif
+#if defined(__x86_64__) || defined(_M_X64)
+#define FAST_CLOCKS_TSC 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+#endif
+
+// Clocks with a cheaper `now()` than `std::chrono::steady_clock`
+//
+// Both clocks satisfy the requirements of a clock, so `mp_units::now<Clock>()` returns their time points
+// as quantity points measured from their own `mp_units::chrono_point_origin<Clock>`. The time points of
+// different clocks have different absolute point origins and cannot be subtracted from each other.
+
+namespace clocks {
+
+/**
+ * @brief A monotonic clock with a resolution of a scheduler tick (typically 1-4 ms)
+ *
+ * On Linux it reads `CLOCK_MONOTONIC_COARSE`, which is served from the vDSO without reading any hardware
+ * counter. On other platforms it falls back to `std::chrono::steady_clock`.
+ */
+struct coarse_steady_clock {
+  using duration = std::chrono::nanoseconds;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<coarse_steady_clock>;
+  static constexpr bool is_steady = true;
+
+  [[nodiscard]] static time_point now() noexcept
+  {
+#if defined(__linux__) && defined(CLOCK_MONOTONIC_COARSE)
+    timespec ts{};
+    ::clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return time_point(std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec));
+#else
+    return time_point(std::chrono::steady_clock::now().time_since_epoch());
+#endif
+  }
+};
+
+/**
+ * @brief A monotonic clock reading the time-stamp counter of the CPU
+ *
+ * The counter is used only if the CPU reports an invariant TSC (constant rate in all power states). Its
+ * frequency is calibrated against `std::chrono::steady_clock` on the first use, which blocks for
+ * `calibration_time`; call `calibrate()` at startup to avoid that on a hot path. Without an invariant TSC
+ * the clock falls back to `std::chrono::steady_clock`.
+ */
+struct tsc_clock {
+  using duration = std::chrono::nanoseconds;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<tsc_clock>;
+  static constexpr bool is_steady = true;
+  static constexpr std::chrono::milliseconds calibration_time{20};
+
+  /**
+   * @brief Returns `true` if the time-stamp counter is used
+   */
+  [[nodiscard]] static bool invariant_tsc() noexcept { return calibration().shift != 0; }
+
+  static void calibrate() noexcept { (void)calibration(); }
+
+  [[nodiscard]] static time_point now() noexcept
+  {
+    const calibration_data& c = calibration();
+#ifdef FAST_CLOCKS_TSC
+    if (c.shift != 0) return time_point(duration(c.base_ns + scale(__rdtsc() - c.base_ticks, c.mult, c.shift)));
+#endif
+    return time_point(std::chrono::steady_clock::now().time_since_epoch() - c.steady_offset);
+  }
+
+private:
+  // `ns = base_ns + ((ticks - base_ticks) * mult) >> shift`
+  struct calibration_data {
+    std::uint64_t base_ticks = 0;
+    rep base_ns = 0;
+    std::uint64_t mult = 0;
+    unsigned shift = 0;
+    duration steady_offset{};
+  };
+
+#ifdef FAST_CLOCKS_TSC
+  [[nodiscard]] static rep scale(std::uint64_t ticks, std::uint64_t mult, unsigned shift) noexcept
+  {
+#if defined(__SIZEOF_INT128__)
+    __extension__ using uint128 = unsigned __int128;
+    return static_cast<rep>((static_cast<uint128>(ticks) * mult) >> shift);
+#else
+    std::uint64_t high = 0;
+    const std::uint64_t low = _umul128(ticks, mult, &high);
+    return static_cast<rep>(__shiftright128(low, high, static_cast<unsigned char>(shift)));
+#endif
+  }
+
+  [[nodiscard]] static bool has_invariant_tsc() noexcept
+  {
+    unsigned regs[4] = {};
+#if defined(_MSC_VER)
+    __cpuid(reinterpret_cast<int*>(regs), 0x80000000);
+    if (regs[0] < 0x80000007) return false;
+    __cpuid(reinterpret_cast<int*>(regs), 0x80000007);
+#else
+    if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007) return false;
+    __get_cpuid(0x80000007, &regs[0], &regs[1], &regs[2], &regs[3]);
+#endif
+    return (regs[3] & (1u << 8)) != 0;
+  }
+#endif
+
+  [[nodiscard]] static calibration_data make_calibration() noexcept
+  {
+    calibration_data c;
+    // time points of the fallback start at the same epoch as the ones of the counter
+    const auto steady_start = std::chrono::steady_clock::now().time_since_epoch();
+    c.steady_offset = steady_start;
+#ifdef FAST_CLOCKS_TSC
+    if (!has_invariant_tsc()) return c;
+    const std::uint64_t ticks_start = __rdtsc();
+    std::this_thread::sleep_for(calibration_time);
+    const auto steady_end = std::chrono::steady_clock::now().time_since_epoch();
+    const std::uint64_t ticks_end = __rdtsc();
+    const auto ns = static_cast<std::uint64_t>((steady_end - steady_start).count());
+    const std::uint64_t ticks = ticks_end - ticks_start;
+    if (ticks == 0 || ns == 0) return c;
+    // nanoseconds per tick with 32 fractional bits
+    c.shift = 32;
+    c.mult = static_cast<std::uint64_t>((static_cast<long double>(ns) * (1ull << 32)) / ticks);
+    c.base_ticks = ticks_end;
+    c.base_ns = (steady_end - steady_start).count();
+#endif
+    return c;
+  }
+
+  [[nodiscard]] static const calibration_data& calibration() noexcept
+  {
+    static const calibration_data c = make_calibration();
+    return c;
+  }
+};
+
+}  // namespace clocks
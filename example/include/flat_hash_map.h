@@ -0,0 +1,245 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/contracts.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#endif
+
+// An open-addressing hash map for small, trivially copyable keys (e.g. quantities and quantity points)
+//
+// The entries are stored inline in a single array, so a lookup touches one or two consecutive cache lines
+// instead of following the node pointers of `std::unordered_map`. Collisions are resolved with linear
+// probing, the home slot is selected with Fibonacci hashing of the `Hash` result (which makes the identity
+// `std::hash` of integers usable with a power-of-two capacity), and the erasure shifts the following
+// entries back instead of leaving tombstones. The keys are compared directly as they are cheap to copy and
+// compare, so no hashes are stored.
+//
+// As with `std::unordered_map`, the keys are looked up with `KeyEqual` of the exact key type. Quantities
+// of other units should be converted to the key type first, and floating-point `NaN` keys can never be
+// found.
+
+namespace containers {
+
+template<typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+  requires std::is_trivially_copyable_v<Key> && std::is_default_constructible_v<Key> &&
+           std::is_default_constructible_v<Value> && std::is_move_assignable_v<Value>
+class flat_hash_map {
+public:
+  struct value_type {
+    Key key;
+    Value value;
+  };
+  using key_type = Key;
+  using mapped_type = Value;
+  using size_type = std::size_t;
+
+private:
+  template<bool Const>
+  class iterator_impl {
+    using map_type = std::conditional_t<Const, const flat_hash_map, flat_hash_map>;
+    map_type* map_ = nullptr;
+    std::size_t index_ = 0;
+
+    friend flat_hash_map;
+    friend iterator_impl<!Const>;
+    constexpr iterator_impl(map_type* map, std::size_t index) : map_(map), index_(index) { skip_empty(); }
+    constexpr void skip_empty()
+    {
+      while (index_ < map_->used_.size() && !map_->used_[index_]) ++index_;
+    }
+
+  public:
+    using value_type = flat_hash_map::value_type;
+    using reference = std::conditional_t<Const, const value_type&, value_type&>;
+    using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    iterator_impl() = default;
+    template<bool C = Const>
+      requires C
+    constexpr iterator_impl(const iterator_impl<false>& other) : map_(other.map_), index_(other.index_)
+    {
+    }
+
+    [[nodiscard]] constexpr reference operator*() const { return map_->slots_[index_]; }
+    [[nodiscard]] constexpr pointer operator->() const { return &map_->slots_[index_]; }
+    constexpr iterator_impl& operator++()
+    {
+      ++index_;
+      skip_empty();
+      return *this;
+    }
+    constexpr iterator_impl operator++(int)
+    {
+      iterator_impl tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    [[nodiscard]] friend constexpr bool operator==(const iterator_impl& lhs, const iterator_impl& rhs)
+    {
+      return lhs.index_ == rhs.index_;
+    }
+  };
+
+public:
+  using iterator = iterator_impl<false>;
+  using const_iterator = iterator_impl<true>;
+
+  flat_hash_map() = default;
+  explicit flat_hash_map(size_type capacity) { reserve(capacity); }
+
+  [[nodiscard]] size_type size() const noexcept { return size_; }
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+  [[nodiscard]] size_type capacity() const noexcept { return used_.size(); }
+
+  [[nodiscard]] iterator begin() { return {this, 0}; }
+  [[nodiscard]] iterator end() { return {this, used_.size()}; }
+  [[nodiscard]] const_iterator begin() const { return {this, 0}; }
+  [[nodiscard]] const_iterator end() const { return {this, used_.size()}; }
+
+  /**
+   * @brief Makes room for at least `count` entries without rehashing
+   */
+  void reserve(size_type count)
+  {
+    // keep the load factor not greater than 3/4
+    const size_type required = std::bit_ceil(std::max<size_type>(count + count / 3 + 1, min_capacity));
+    if (required > capacity()) rehash(required);
+  }
+
+  void clear()
+  {
+    std::ranges::fill(used_, std::uint8_t{0});
+    for (value_type& slot : slots_) slot.value = Value{};
+    size_ = 0;
+  }
+
+  [[nodiscard]] iterator find(const Key& key) { return {this, find_index(key)}; }
+  [[nodiscard]] const_iterator find(const Key& key) const { return {this, find_index(key)}; }
+  [[nodiscard]] bool contains(const Key& key) const { return find_index(key) != used_.size(); }
+
+  /**
+   * @brief Inserts a value constructed from `args` if `key` is not present yet
+   *
+   * @return the iterator to the entry of `key` and `true` if the insertion took place
+   */
+  template<typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+  {
+    if (size_ + 1 > capacity() - capacity() / 4) reserve(size_ + 1);
+    std::size_t i = home_of(key);
+    for (; used_[i]; i = next(i))
+      if (equal_(slots_[i].key, key)) return {iterator{this, i}, false};
+    slots_[i].key = key;
+    slots_[i].value = Value(std::forward<Args>(args)...);
+    used_[i] = 1;
+    ++size_;
+    return {iterator{this, i}, true};
+  }
+
+  Value& operator[](const Key& key) { return try_emplace(key).first->value; }
+
+  /**
+   * @brief Removes the entry of `key`
+   *
+   * @return the number of removed entries (`0` or `1`)
+   */
+  size_type erase(const Key& key)
+  {
+    const std::size_t pos = find_index(key);
+    if (pos == used_.size()) return 0;
+    // shift back the entries that would become unreachable from their home slots
+    std::size_t hole = pos;
+    for (std::size_t i = next(pos); used_[i]; i = next(i)) {
+      if (((i - home_of(slots_[i].key)) & mask_) >= ((i - hole) & mask_)) {
+        slots_[hole] = std::move(slots_[i]);
+        hole = i;
+      }
+    }
+    used_[hole] = 0;
+    slots_[hole].value = Value{};
+    --size_;
+    return 1;
+  }
+
+private:
+  static constexpr size_type min_capacity = 16;
+
+  std::vector<value_type> slots_;
+  std::vector<std::uint8_t> used_;
+  size_type size_ = 0;
+  std::size_t mask_ = 0;
+  int shift_ = 64;
+  [[no_unique_address]] Hash hash_;
+  [[no_unique_address]] KeyEqual equal_;
+
+  [[nodiscard]] std::size_t next(std::size_t i) const { return (i + 1) & mask_; }
+
+  [[nodiscard]] std::size_t home_of(const Key& key) const
+  {
+    // Fibonacci hashing spreads the hashes with low entropy in the high bits over the whole table
+    return static_cast<std::size_t>((static_cast<std::uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ULL) >> shift_);
+  }
+
+  [[nodiscard]] std::size_t find_index(const Key& key) const
+  {
+    if (size_ == 0) return used_.size();
+    for (std::size_t i = home_of(key); used_[i]; i = next(i))
+      if (equal_(slots_[i].key, key)) return i;
+    return used_.size();
+  }
+
+  void rehash(size_type new_capacity)
+  {
+    MP_UNITS_EXPECTS(std::has_single_bit(new_capacity));
+    std::vector<value_type> old_slots(new_capacity);
+    std::vector<std::uint8_t> old_used(new_capacity);
+    old_slots.swap(slots_);
+    old_used.swap(used_);
+    mask_ = new_capacity - 1;
+    shift_ = 64 - std::countr_zero(new_capacity);
+    for (std::size_t j = 0; j < old_used.size(); ++j) {
+      if (!old_used[j]) continue;
+      std::size_t i = home_of(old_slots[j].key);
+      while (used_[i]) i = next(i);
+      slots_[i] = std::move(old_slots[j]);
+      used_[i] = 1;
+    }
+  }
+};
+
+}  // namespace containers
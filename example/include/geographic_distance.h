@@ -0,0 +1,334 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "geographic.h"
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/contracts.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <numbers>
+#include <span>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/framework.h>
+#include <mp-units/systems/isq/space_and_time.h>
+#include <mp-units/systems/si.h>
+#endif
+
+// Batch great-circle and geodesic distances
+//
+// `position_array` stores positions in a structure-of-arrays layout together with the per-point terms
+// that the distance formulas need (radians, cosine of latitude, and the reduced latitude on the WGS-84
+// ellipsoid). The kernels below run over contiguous raw arrays without any branches in the haversine case,
+// so they auto-vectorize when the math library provides vector versions of the trigonometric functions
+// (e.g. glibc's libmvec with `-O3 -fno-math-errno`).
+
+namespace geographic {
+
+namespace detail {
+
+// mean Earth radius used by `spherical_distance()`
+inline constexpr double earth_radius_km = 6'371.;
+
+// WGS-84 ellipsoid
+inline constexpr double wgs84_a_km = 6'378.137;
+inline constexpr double wgs84_f = 1. / 298.257223563;
+inline constexpr double wgs84_b_km = wgs84_a_km * (1. - wgs84_f);
+
+template<typename T>
+[[nodiscard]] T haversine_central_angle(T lat1, T lon1, T cos_lat1, T lat2, T lon2, T cos_lat2)
+{
+  const T sin_dlat = std::sin((lat2 - lat1) / 2);
+  const T sin_dlon = std::sin((lon2 - lon1) / 2);
+  const T a = sin_dlat * sin_dlat + cos_lat1 * cos_lat2 * sin_dlon * sin_dlon;
+  return 2 * std::asin(std::sqrt(std::min(a, T{1})));
+}
+
+template<typename T>
+struct vincenty_result {
+  T km;
+  bool converged;
+};
+
+// https://en.wikipedia.org/wiki/Vincenty%27s_formulae#Inverse_problem
+// Returns the ellipsoidal distance in kilometres. For nearly antipodal points the iteration may not converge
+// and the returned estimate is not reliable.
+template<typename T>
+[[nodiscard]] vincenty_result<T> vincenty_distance_km(T lon1, T sin_u1, T cos_u1, T lon2, T sin_u2, T cos_u2)
+{
+  constexpr int max_iterations = 200;
+  constexpr T f = static_cast<T>(wgs84_f);
+  constexpr T a = static_cast<T>(wgs84_a_km);
+  constexpr T b = static_cast<T>(wgs84_b_km);
+  constexpr T tolerance = sizeof(T) >= 8 ? T(1e-12) : T(1e-6);
+
+  const T l = lon2 - lon1;
+  T lambda = l;
+  T sin_sigma{}, cos_sigma{}, sigma{}, cos_sq_alpha{}, cos_2sigma_m{};
+  bool converged = false;
+  for (int i = 0; i < max_iterations; ++i) {
+    const T sin_lambda = std::sin(lambda);
+    const T cos_lambda = std::cos(lambda);
+    const T t1 = cos_u2 * sin_lambda;
+    const T t2 = cos_u1 * sin_u2 - sin_u1 * cos_u2 * cos_lambda;
+    sin_sigma = std::sqrt(t1 * t1 + t2 * t2);
+    if (sin_sigma == 0) return {T{}, true};  // coincident points
+    cos_sigma = sin_u1 * sin_u2 + cos_u1 * cos_u2 * cos_lambda;
+    sigma = std::atan2(sin_sigma, cos_sigma);
+    const T sin_alpha = cos_u1 * cos_u2 * sin_lambda / sin_sigma;
+    cos_sq_alpha = 1 - sin_alpha * sin_alpha;
+    // equatorial line has `cos_sq_alpha == 0`
+    cos_2sigma_m = cos_sq_alpha != 0 ? cos_sigma - 2 * sin_u1 * sin_u2 / cos_sq_alpha : T{};
+    const T c = f / 16 * cos_sq_alpha * (4 + f * (4 - 3 * cos_sq_alpha));
+    const T prev = lambda;
+    lambda = l + (1 - c) * f * sin_alpha *
+                   (sigma + c * sin_sigma * (cos_2sigma_m + c * cos_sigma * (-1 + 2 * cos_2sigma_m * cos_2sigma_m)));
+    if (std::abs(lambda - prev) <= tolerance) {
+      converged = std::abs(lambda) <= std::numbers::pi_v<T>;
+      break;
+    }
+  }
+
+  const T u_sq = cos_sq_alpha * (a * a - b * b) / (b * b);
+  const T big_a = 1 + u_sq / 16384 * (4096 + u_sq * (-768 + u_sq * (320 - 175 * u_sq)));
+  const T big_b = u_sq / 1024 * (256 + u_sq * (-128 + u_sq * (74 - 47 * u_sq)));
+  const T delta_sigma =
+    big_b * sin_sigma *
+    (cos_2sigma_m + big_b / 4 *
+                      (cos_sigma * (-1 + 2 * cos_2sigma_m * cos_2sigma_m) -
+                       big_b / 6 * cos_2sigma_m * (-3 + 4 * sin_sigma * sin_sigma) *
+                         (-3 + 4 * cos_2sigma_m * cos_2sigma_m)));
+  return {b * big_a * (sigma - delta_sigma), converged};
+}
+
+// the terms of a position reused by every distance computation
+template<typename T>
+struct point_terms {
+  T lat;      // radians
+  T lon;      // radians
+  T cos_lat;  // for haversine
+  T sin_u;    // reduced latitude for Vincenty
+  T cos_u;
+};
+
+template<typename T>
+[[nodiscard]] point_terms<T> make_point_terms(const position<T>& pos)
+{
+  using namespace mp_units;
+  constexpr T deg_to_rad = std::numbers::pi_v<T> / 180;
+  const T lat = T(pos.lat.quantity_from_zero().numerical_value_in(si::degree)) * deg_to_rad;
+  const T lon = T(pos.lon.quantity_from_zero().numerical_value_in(si::degree)) * deg_to_rad;
+  const T u = std::atan((1 - static_cast<T>(wgs84_f)) * std::tan(lat));
+  return {lat, lon, std::cos(lat), std::sin(u), std::cos(u)};
+}
+
+template<typename T>
+[[nodiscard]] distance haversine_distance(const point_terms<T>& from, const point_terms<T>& to)
+{
+  return static_cast<double>(earth_radius_km * haversine_central_angle(from.lat, from.lon, from.cos_lat, to.lat,
+                                                                       to.lon, to.cos_lat)) *
+         distance::reference;
+}
+
+// falls back to the spherical distance for the nearly antipodal points where Vincenty's method does not converge
+template<typename T>
+[[nodiscard]] distance vincenty_distance(const point_terms<T>& from, const point_terms<T>& to)
+{
+  const auto [km, converged] = vincenty_distance_km(from.lon, from.sin_u, from.cos_u, to.lon, to.sin_u, to.cos_u);
+  if (!converged) return haversine_distance(from, to);
+  return static_cast<double>(km) * distance::reference;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Positions stored as a structure of arrays
+ *
+ * Besides latitude and longitude (kept in radians) every entry caches the terms reused by every distance
+ * computation, so that they are computed once per point rather than once per pair.
+ *
+ * @tparam T floating-point type used for storage and computations
+ */
+template<typename T = double>
+class position_array {
+  std::vector<T> lat_;      // radians
+  std::vector<T> lon_;      // radians
+  std::vector<T> cos_lat_;  // for haversine
+  std::vector<T> sin_u_;    // reduced latitude for Vincenty
+  std::vector<T> cos_u_;
+
+  static constexpr T deg_to_rad = std::numbers::pi_v<T> / 180;
+
+public:
+  using value_type = position<T>;
+  using size_type = std::size_t;
+
+  position_array() = default;
+  position_array(std::initializer_list<position<T>> init)
+  {
+    reserve(init.size());
+    for (const auto& pos : init) push_back(pos);
+  }
+
+  void reserve(size_type n)
+  {
+    lat_.reserve(n);
+    lon_.reserve(n);
+    cos_lat_.reserve(n);
+    sin_u_.reserve(n);
+    cos_u_.reserve(n);
+  }
+
+  void clear() noexcept
+  {
+    lat_.clear();
+    lon_.clear();
+    cos_lat_.clear();
+    sin_u_.clear();
+    cos_u_.clear();
+  }
+
+  void push_back(position<T> pos)
+  {
+    const detail::point_terms<T> terms = detail::make_point_terms(pos);
+    lat_.push_back(terms.lat);
+    lon_.push_back(terms.lon);
+    cos_lat_.push_back(terms.cos_lat);
+    sin_u_.push_back(terms.sin_u);
+    cos_u_.push_back(terms.cos_u);
+  }
+
+  [[nodiscard]] position<T> operator[](size_type i) const
+  {
+    using namespace mp_units;
+    MP_UNITS_EXPECTS(i < size());
+    return {latitude<T>{ranged_representation<T, -90, 90>{lat_[i] / deg_to_rad} * si::degree, equator},
+            longitude<T>{ranged_representation<T, -180, 180>{lon_[i] / deg_to_rad} * si::degree, prime_meridian}};
+  }
+
+  [[nodiscard]] detail::point_terms<T> terms(size_type i) const
+  {
+    MP_UNITS_EXPECTS(i < size());
+    return {lat_[i], lon_[i], cos_lat_[i], sin_u_[i], cos_u_[i]};
+  }
+
+  [[nodiscard]] size_type size() const noexcept { return lat_.size(); }
+  [[nodiscard]] bool empty() const noexcept { return lat_.empty(); }
+
+  // raw columns used by the batch kernels
+  [[nodiscard]] std::span<const T> lat_rad() const noexcept { return lat_; }
+  [[nodiscard]] std::span<const T> lon_rad() const noexcept { return lon_; }
+  [[nodiscard]] std::span<const T> cos_lat() const noexcept { return cos_lat_; }
+  [[nodiscard]] std::span<const T> sin_reduced_lat() const noexcept { return sin_u_; }
+  [[nodiscard]] std::span<const T> cos_reduced_lat() const noexcept { return cos_u_; }
+};
+
+// one-to-one
+
+template<typename T>
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+[[nodiscard]] distance haversine_distance(position<T> from, position<T> to)
+{
+  return detail::haversine_distance(detail::make_point_terms(from), detail::make_point_terms(to));
+}
+
+/**
+ * @brief Geodesic distance on the WGS-84 ellipsoid computed with Vincenty's inverse formula
+ *
+ * For the nearly antipodal points, where the iteration does not converge, the spherical distance
+ * is returned instead.
+ */
+template<typename T>
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+[[nodiscard]] distance vincenty_distance(position<T> from, position<T> to)
+{
+  return detail::vincenty_distance(detail::make_point_terms(from), detail::make_point_terms(to));
+}
+
+// one-to-many: `out[i]` is the distance between `from` and `to[i]`
+
+template<typename T>
+void haversine_distance(position<T> from, const position_array<T>& to, std::span<distance> out)
+{
+  MP_UNITS_EXPECTS(out.size() == to.size());
+  const detail::point_terms<T> origin = detail::make_point_terms(from);
+  const T* const lat2 = to.lat_rad().data();
+  const T* const lon2 = to.lon_rad().data();
+  const T* const cos_lat2 = to.cos_lat().data();
+  for (std::size_t i = 0; i < out.size(); ++i)
+    out[i] = static_cast<double>(detail::earth_radius_km *
+                                 detail::haversine_central_angle(origin.lat, origin.lon, origin.cos_lat, lat2[i],
+                                                                 lon2[i], cos_lat2[i])) *
+             distance::reference;
+}
+
+template<typename T>
+void vincenty_distance(position<T> from, const position_array<T>& to, std::span<distance> out)
+{
+  MP_UNITS_EXPECTS(out.size() == to.size());
+  const detail::point_terms<T> origin = detail::make_point_terms(from);
+  for (std::size_t i = 0; i < out.size(); ++i) out[i] = detail::vincenty_distance(origin, to.terms(i));
+}
+
+// many-to-many: `out` is a row-major `from.size() x to.size()` matrix
+
+template<typename T>
+void haversine_distance(const position_array<T>& from, const position_array<T>& to, std::span<distance> out)
+{
+  MP_UNITS_EXPECTS(out.size() == from.size() * to.size());
+  const T* const lat2 = to.lat_rad().data();
+  const T* const lon2 = to.lon_rad().data();
+  const T* const cos_lat2 = to.cos_lat().data();
+  for (std::size_t r = 0; r < from.size(); ++r) {
+    const T lat1 = from.lat_rad()[r];
+    const T lon1 = from.lon_rad()[r];
+    const T cos_lat1 = from.cos_lat()[r];
+    distance* const row = out.data() + r * to.size();
+    for (std::size_t i = 0; i < to.size(); ++i)
+      row[i] = static_cast<double>(detail::earth_radius_km * detail::haversine_central_angle(
+                                                               lat1, lon1, cos_lat1, lat2[i], lon2[i], cos_lat2[i])) *
+               distance::reference;
+  }
+}
+
+template<typename T>
+void vincenty_distance(const position_array<T>& from, const position_array<T>& to, std::span<distance> out)
+{
+  MP_UNITS_EXPECTS(out.size() == from.size() * to.size());
+  for (std::size_t r = 0; r < from.size(); ++r) {
+    const detail::point_terms<T> origin = from.terms(r);
+    distance* const row = out.data() + r * to.size();
+    for (std::size_t i = 0; i < to.size(); ++i) row[i] = detail::vincenty_distance(origin, to.terms(i));
+  }
+}
+
+}  // namespace geographic
@@ -0,0 +1,287 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "geographic.h"
+#include "geographic_distance.h"
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/contracts.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/framework.h>
+#include <mp-units/systems/isq/space_and_time.h>
+#include <mp-units/systems/si.h>
+#endif
+
+namespace geographic {
+
+/**
+ * @brief A uniform latitude/longitude grid index over geographic positions
+ *
+ * Every position is stored in a cell of the size provided at construction. Proximity queries visit only
+ * the cells overlapping the angular extent of the query area and then filter the candidates with
+ * `spherical_distance()`, which is also used to sort the results.
+ *
+ * @tparam Id identifier of an indexed object (must be hashable)
+ * @tparam T floating-point type of the positions
+ */
+template<typename Id, typename T = long double>
+class spatial_index {
+public:
+  struct entry {
+    Id id;
+    position<T> pos;
+  };
+
+  struct match {
+    Id id;
+    position<T> pos;
+    distance dist;
+  };
+
+  template<mp_units::QuantityOf<mp_units::isq::length> Q>
+  explicit spatial_index(Q cell_size)
+  {
+    const double cell_deg = to_degrees(cell_size);
+    MP_UNITS_EXPECTS(cell_deg > 0);
+    // the cells are slightly narrower than requested so that they cover the globe exactly and the columns
+    // wrap around the antimeridian without a narrower last column
+    cols_ = static_cast<std::uint64_t>(std::ceil(360. / cell_deg));
+    rows_ = static_cast<std::uint64_t>(std::ceil(180. / cell_deg));
+    lon_cell_deg_ = 360. / static_cast<double>(cols_);
+    lat_cell_deg_ = 180. / static_cast<double>(rows_);
+  }
+
+  /**
+   * @brief Replaces the contents of the index with `entries`
+   *
+   * Cell keys are computed on `threads` worker threads; the entries are then bucketed in a single pass.
+   */
+  void build(std::span<const entry> entries, unsigned threads = std::thread::hardware_concurrency())
+  {
+    clear();
+    std::vector<std::uint64_t> keys(entries.size());
+    const std::size_t workers = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(entries.size(), 1));
+    const std::size_t chunk = (entries.size() + workers - 1) / workers;
+    {
+      std::vector<std::jthread> pool;
+      pool.reserve(workers);
+      for (std::size_t w = 0; w < workers; ++w)
+        pool.emplace_back([&, begin = w * chunk] {
+          const std::size_t end = std::min(begin + chunk, entries.size());
+          for (std::size_t i = begin; i < end; ++i) keys[i] = key_of(entries[i].pos);
+        });
+    }
+    locations_.reserve(entries.size());
+    for (std::size_t i = 0; i < entries.size(); ++i) insert(keys[i], entries[i]);
+  }
+
+  /**
+   * @brief Adds an object to the index or replaces the entry with the same identifier
+   */
+  void insert(const entry& e) { insert(key_of(e.pos), e); }
+
+  /**
+   * @brief Removes the object with the given identifier
+   *
+   * @return `true` if the object was found in the index
+   */
+  bool remove(const Id& id)
+  {
+    const auto loc = locations_.find(id);
+    if (loc == locations_.end()) return false;
+    erase_from_cell(loc->second, id);
+    locations_.erase(loc);
+    return true;
+  }
+
+  void clear() noexcept
+  {
+    cells_.clear();
+    locations_.clear();
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return locations_.size(); }
+  [[nodiscard]] bool empty() const noexcept { return locations_.empty(); }
+
+  /**
+   * @brief Returns all the objects not further than `radius` from `center` sorted by distance
+   */
+  template<mp_units::QuantityOf<mp_units::isq::length> Q>
+  [[nodiscard]] std::vector<match> within_radius(position<T> center, Q radius) const
+  {
+    const double r_deg = to_degrees(radius);
+    const distance r =
+      mp_units::quantity_cast<mp_units::isq::distance>(mp_units::value_cast<double>(radius).in(distance::unit));
+    std::vector<match> res;
+    visit(center, r_deg, r_deg, [&](const entry& e) {
+      const distance d = spherical_distance(center, e.pos);
+      if (d <= r) res.push_back({e.id, e.pos, d});
+    });
+    sort_by_distance(res);
+    return res;
+  }
+
+  /**
+   * @brief Returns all the objects inside of the box centered at `center` sorted by distance to its center
+   *
+   * @param half_height north-south distance from the center to the edge of the box
+   * @param half_width east-west distance from the center to the edge of the box (measured at center's latitude)
+   */
+  template<mp_units::QuantityOf<mp_units::isq::length> Q1, mp_units::QuantityOf<mp_units::isq::length> Q2>
+  [[nodiscard]] std::vector<match> within_box(position<T> center, Q1 half_height, Q2 half_width) const
+  {
+    const double dlat = to_degrees(half_height);
+    const double dlon = lon_extent(lat_deg(center), to_degrees(half_width));
+    const double clat = lat_deg(center);
+    const double clon = lon_deg(center);
+    std::vector<match> res;
+    visit(center, dlat, to_degrees(half_width), [&](const entry& e) {
+      double diff = std::abs(lon_deg(e.pos) - clon);
+      if (diff > 180.) diff = 360. - diff;
+      if (std::abs(lat_deg(e.pos) - clat) <= dlat && diff <= dlon)
+        res.push_back({e.id, e.pos, spherical_distance(center, e.pos)});
+    });
+    sort_by_distance(res);
+    return res;
+  }
+
+private:
+  double lon_cell_deg_;
+  double lat_cell_deg_;
+  std::uint64_t cols_;
+  std::uint64_t rows_;
+  std::unordered_map<std::uint64_t, std::vector<entry>> cells_;
+  std::unordered_map<Id, std::uint64_t> locations_;
+
+  template<mp_units::QuantityOf<mp_units::isq::length> Q>
+  [[nodiscard]] static double to_degrees(Q q)
+  {
+    using namespace mp_units;
+    return mp_units::value_cast<double>(q).numerical_value_in(si::kilo<si::metre>) / detail::earth_radius_km * 180. /
+           std::numbers::pi;
+  }
+
+  [[nodiscard]] static double lat_deg(position<T> pos)
+  {
+    return static_cast<double>(T(pos.lat.quantity_from_zero().numerical_value_in(mp_units::si::degree)));
+  }
+
+  [[nodiscard]] static double lon_deg(position<T> pos)
+  {
+    return static_cast<double>(T(pos.lon.quantity_from_zero().numerical_value_in(mp_units::si::degree)));
+  }
+
+  // longitude extent of the east-west angular distance at a given latitude
+  [[nodiscard]] static double lon_extent(double lat, double angle_deg)
+  {
+    const double c = std::cos(lat * std::numbers::pi / 180.);
+    return c * 180. <= angle_deg ? 180. : angle_deg / c;
+  }
+
+  [[nodiscard]] std::uint64_t row_of(double lat) const
+  {
+    return std::min(static_cast<std::uint64_t>((lat + 90.) / lat_cell_deg_), rows_ - 1);
+  }
+
+  [[nodiscard]] std::uint64_t col_of(double lon) const
+  {
+    return std::min(static_cast<std::uint64_t>((lon + 180.) / lon_cell_deg_), cols_ - 1);
+  }
+
+  [[nodiscard]] std::uint64_t key_of(position<T> pos) const
+  {
+    return row_of(lat_deg(pos)) * cols_ + col_of(lon_deg(pos));
+  }
+
+  void insert(std::uint64_t key, const entry& e)
+  {
+    const auto [loc, inserted] = locations_.try_emplace(e.id, key);
+    if (!inserted) {
+      erase_from_cell(loc->second, e.id);
+      loc->second = key;
+    }
+    cells_[key].push_back(e);
+  }
+
+  void erase_from_cell(std::uint64_t key, const Id& id)
+  {
+    auto& cell = cells_[key];
+    const auto it = std::ranges::find(cell, id, &entry::id);
+    MP_UNITS_ASSERT(it != cell.end());
+    *it = std::move(cell.back());
+    cell.pop_back();
+    if (cell.empty()) cells_.erase(key);
+  }
+
+  // calls `f` for every entry stored in the cells overlapping the given angular extent around `center`
+  template<typename F>
+  void visit(position<T> center, double dlat, double dlon_at_center, F&& f) const
+  {
+    const double clat = lat_deg(center);
+    const double lat_min = std::max(clat - dlat, -90.);
+    const double lat_max = std::min(clat + dlat, 90.);
+    // the widest longitude extent is at the latitude closest to the pole
+    const double dlon = lon_extent(std::max(std::abs(lat_min), std::abs(lat_max)), dlon_at_center);
+    const std::uint64_t first_row = row_of(lat_min);
+    const std::uint64_t last_row = row_of(lat_max);
+
+    // wrap around the antimeridian
+    std::uint64_t first_col = 0, col_count = cols_;
+    if (dlon < 180.) {
+      double west = lon_deg(center) - dlon;
+      if (west < -180.) west += 360.;
+      first_col = col_of(west);
+      col_count = std::min(static_cast<std::uint64_t>(std::ceil(2 * dlon / lon_cell_deg_)) + 1, cols_);
+    }
+
+    for (std::uint64_t row = first_row; row <= last_row; ++row)
+      for (std::uint64_t i = 0; i < col_count; ++i) {
+        const auto it = cells_.find(row * cols_ + (first_col + i) % cols_);
+        if (it == cells_.end()) continue;
+        for (const entry& e : it->second) f(e);
+      }
+  }
+
+  static void sort_by_distance(std::vector<match>& res)
+  {
+    std::ranges::sort(res, {}, [](const match& m) { return m.dist; });
+  }
+};
+
+}  // namespace geographic
@@ -0,0 +1,328 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/contracts.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <utility>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/framework.h>
+#endif
+
+// Lookup tables with quantity axes and linear or bilinear interpolation
+//
+// An axis holds the breakpoints of a table as raw numerical values in the unit of its quantity type:
+// - `uniform_axis` finds the cell of an argument in O(1) with a single multiplication and subtraction,
+// - `nonuniform_axis` checks the cell found by the previous lookup and its neighbor first and falls back
+//   to the binary search only if the argument moved further.
+//
+// The arguments have to be implicitly convertible to the quantity types of the axes and the values to the
+// quantity type of the table, so mismatched tables fail to compile. When the unit of an argument differs
+// from the unit of its axis, the compile-time conversion factor is folded into the scale of the index
+// computation instead of converting the argument first. Outside of the axis range the values are clamped
+// to the edge of the table. The arguments must not be NaN.
+//
+// All the types are literal, so tables of compile-time data can be `constexpr` variables. The batch
+// overloads of `evaluate()` run over contiguous spans without branches for uniform axes, so they
+// auto-vectorize on targets with gather instructions (e.g. `-O3 -mavx2 -fno-trapping-math`).
+
+namespace tables {
+
+template<std::floating_point Rep>
+struct cell {
+  std::size_t index;  // index of the first breakpoint of the cell
+  Rep fraction;       // position of the argument inside of the cell in the range `[0, 1]`
+};
+
+namespace detail {
+
+// numerical value of `x` in `To::unit` multiplied by `scale`, with the conversion factor folded into `scale`
+template<mp_units::Quantity To, mp_units::Quantity From>
+[[nodiscard]] constexpr typename To::rep scaled_value(const From& x, typename To::rep scale)
+{
+  using rep = To::rep;
+  if constexpr (From::unit == To::unit)
+    return static_cast<rep>(x.numerical_value_ref_in(From::unit)) * scale;
+  else {
+    constexpr rep factor =
+      mp_units::quantity<From::reference, rep>{rep{1}, From::reference}.numerical_value_in(To::unit);
+    return static_cast<rep>(x.numerical_value_ref_in(From::unit)) * (factor * scale);
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief `N` equally spaced breakpoints spanning `[first, last]`
+ */
+template<mp_units::Quantity Q, std::size_t N>
+  requires std::floating_point<typename Q::rep> && (N >= 2) && (N <= std::numeric_limits<std::int32_t>::max())
+class uniform_axis {
+public:
+  using quantity_type = Q;
+  using rep = Q::rep;
+  static constexpr std::size_t size = N;
+
+  constexpr uniform_axis(Q first, Q last) :
+      first_(first.numerical_value_in(Q::unit)),
+      step_((last.numerical_value_in(Q::unit) - first_) / static_cast<rep>(N - 1)),
+      inv_step_(rep{1} / step_),
+      offset_(first_ * inv_step_)
+  {
+    MP_UNITS_EXPECTS(first < last);
+  }
+
+  [[nodiscard]] constexpr Q operator[](std::size_t i) const
+  {
+    return Q{first_ + step_ * static_cast<rep>(i), Q::reference};
+  }
+
+  template<std::convertible_to<Q> X>
+  [[nodiscard]] constexpr cell<rep> locate(const X& x, std::size_t& /* hint */) const
+  {
+    return locate(x);
+  }
+
+  template<std::convertible_to<Q> X>
+  [[nodiscard]] constexpr cell<rep> locate(const X& x) const
+  {
+    const rep t = std::min(std::max(detail::scaled_value<Q>(x, inv_step_) - offset_, rep{0}), static_cast<rep>(N - 1));
+    // the signed 32-bit conversion has a vector instruction on x86 without AVX-512
+    const auto i = std::min(static_cast<std::int32_t>(t), static_cast<std::int32_t>(N - 2));
+    return {static_cast<std::size_t>(i), t - static_cast<rep>(i)};
+  }
+
+private:
+  rep first_;
+  rep step_;
+  rep inv_step_;
+  rep offset_;
+};
+
+/**
+ * @brief `N` strictly increasing breakpoints
+ */
+template<mp_units::Quantity Q, std::size_t N>
+  requires std::floating_point<typename Q::rep> && (N >= 2)
+class nonuniform_axis {
+public:
+  using quantity_type = Q;
+  using rep = Q::rep;
+  static constexpr std::size_t size = N;
+
+  constexpr explicit nonuniform_axis(const std::array<Q, N>& breakpoints)
+  {
+    for (std::size_t i = 0; i < N; ++i) {
+      points_[i] = breakpoints[i].numerical_value_in(Q::unit);
+      if (i > 0) MP_UNITS_EXPECTS(points_[i - 1] < points_[i]);
+    }
+  }
+
+  [[nodiscard]] constexpr Q operator[](std::size_t i) const { return Q{points_[i], Q::reference}; }
+
+  /**
+   * @brief Finds the cell of `x` starting the search from the cell of the previous lookup
+   *
+   * @param hint the index of the cell of the previous lookup; updated with the index of the found cell
+   */
+  template<std::convertible_to<Q> X>
+  [[nodiscard]] constexpr cell<rep> locate(const X& x, std::size_t& hint) const
+  {
+    const rep v = std::clamp(detail::scaled_value<Q>(x, rep{1}), points_.front(), points_.back());
+    std::size_t i = std::min(hint, N - 2);
+    if (v < points_[i] || v > points_[i + 1]) {
+      if (i + 2 < N && v >= points_[i + 1] && v <= points_[i + 2])
+        ++i;
+      else if (i > 0 && v >= points_[i - 1] && v <= points_[i])
+        --i;
+      else
+        i = static_cast<std::size_t>(std::upper_bound(points_.begin() + 1, points_.end() - 1, v) - points_.begin()) - 1;
+    }
+    hint = i;
+    return {i, (v - points_[i]) / (points_[i + 1] - points_[i])};
+  }
+
+  template<std::convertible_to<Q> X>
+  [[nodiscard]] constexpr cell<rep> locate(const X& x) const
+  {
+    std::size_t hint = 0;
+    return locate(x, hint);
+  }
+
+private:
+  std::array<rep, N> points_{};
+};
+
+template<typename T>
+concept Axis = requires(const T& axis, const typename T::quantity_type& x, std::size_t& hint) {
+  { T::size } -> std::convertible_to<std::size_t>;
+  { axis.locate(x, hint) } -> std::same_as<cell<typename T::rep>>;
+};
+
+/**
+ * @brief A table of values of the quantity type `V` over one or two axes
+ *
+ * The values are stored in the row-major order, i.e. the last axis changes the fastest.
+ */
+template<mp_units::Quantity V, Axis... Axes>
+  requires std::floating_point<typename V::rep> && (sizeof...(Axes) == 1 || sizeof...(Axes) == 2)
+class lookup_table {
+public:
+  using value_type = V;
+  using rep = V::rep;
+  static constexpr std::size_t rank = sizeof...(Axes);
+  static constexpr std::size_t size = (Axes::size * ...);
+
+  template<std::size_t I>
+    requires(I < rank)
+  using axis_type = std::tuple_element_t<I, std::tuple<Axes...>>;
+
+  constexpr lookup_table(const Axes&... axes, const std::array<V, size>& values) : axes_(axes...)
+  {
+    for (std::size_t i = 0; i < size; ++i) values_[i] = values[i].numerical_value_in(V::unit);
+  }
+
+  template<std::size_t I>
+    requires(I < rank)
+  [[nodiscard]] constexpr const axis_type<I>& axis() const
+  {
+    return std::get<I>(axes_);
+  }
+
+  /**
+   * @brief Interpolates the table at the given arguments
+   */
+  template<typename... Xs>
+    requires(sizeof...(Xs) == rank) && (std::convertible_to<Xs, typename Axes::quantity_type> && ...)
+  [[nodiscard]] constexpr V operator()(const Xs&... xs) const
+  {
+    std::array<std::size_t, rank> hints{};
+    return V{interpolate(hints, xs...), V::reference};
+  }
+
+  /**
+   * @brief Interpolates a one-dimensional table at many arguments
+   */
+  template<std::convertible_to<typename axis_type<0>::quantity_type> X>
+    requires(rank == 1)
+  constexpr void evaluate(std::span<const X> xs, std::span<V> out) const
+  {
+    MP_UNITS_EXPECTS(xs.size() == out.size());
+    evaluate_batch(out, xs);
+  }
+
+  /**
+   * @brief Interpolates a two-dimensional table at many pairs of arguments
+   */
+  template<std::convertible_to<typename axis_type<0>::quantity_type> X,
+           std::convertible_to<typename axis_type<rank - 1>::quantity_type> Y>
+    requires(rank == 2)
+  constexpr void evaluate(std::span<const X> xs, std::span<const Y> ys, std::span<V> out) const
+  {
+    MP_UNITS_EXPECTS(xs.size() == out.size() && ys.size() == out.size());
+    evaluate_batch(out, xs, ys);
+  }
+
+  /**
+   * @brief A lookup that caches the cells found by the previous call
+   *
+   * Sequential arguments (e.g. samples of a flight) usually fall into the same or the neighbouring cell
+   * of a non-uniform axis, so the cursor avoids most of the binary searches. Each thread should use its
+   * own cursor.
+   */
+  class cursor {
+  public:
+    constexpr explicit cursor(const lookup_table& table) : table_(&table) {}
+
+    template<typename... Xs>
+      requires(sizeof...(Xs) == rank) && (std::convertible_to<Xs, typename Axes::quantity_type> && ...)
+    [[nodiscard]] constexpr V operator()(const Xs&... xs)
+    {
+      return V{table_->interpolate(hints_, xs...), V::reference};
+    }
+
+  private:
+    const lookup_table* table_;
+    std::array<std::size_t, rank> hints_{};
+  };
+
+private:
+  static constexpr std::size_t batch_block = 64;
+
+  std::tuple<Axes...> axes_;
+  std::array<rep, size> values_{};
+
+  // The values are interpolated into a local buffer first, so the compiler does not have to assume that
+  // `out` aliases the table and can vectorize the gathers from it.
+  template<typename... Args>
+  constexpr void evaluate_batch(std::span<V> out, const Args&... args) const
+  {
+    std::array<std::size_t, rank> hints{};
+    std::array<rep, batch_block> buffer{};
+    for (std::size_t first = 0; first < out.size(); first += batch_block) {
+      const std::size_t count = std::min(batch_block, out.size() - first);
+      for (std::size_t k = 0; k < count; ++k) buffer[k] = interpolate(hints, args[first + k]...);
+      for (std::size_t k = 0; k < count; ++k) out[first + k] = V{buffer[k], V::reference};
+    }
+  }
+
+  template<typename X>
+  [[nodiscard]] constexpr rep interpolate(std::array<std::size_t, rank>& hints, const X& x) const
+  {
+    const auto [i, f] = std::get<0>(axes_).locate(x, hints[0]);
+    const rep v0 = values_[i];
+    const rep v1 = values_[i + 1];
+    return v0 + f * (v1 - v0);
+  }
+
+  template<typename X, typename Y>
+  [[nodiscard]] constexpr rep interpolate(std::array<std::size_t, rank>& hints, const X& x, const Y& y) const
+  {
+    constexpr std::size_t cols = axis_type<1>::size;
+    const auto [i, fx] = std::get<0>(axes_).locate(x, hints[0]);
+    const auto [j, fy] = std::get<1>(axes_).locate(y, hints[1]);
+    const rep v00 = values_[i * cols + j];
+    const rep v01 = values_[i * cols + j + 1];
+    const rep v10 = values_[(i + 1) * cols + j];
+    const rep v11 = values_[(i + 1) * cols + j + 1];
+    const rep v0 = v00 + fy * (v01 - v00);
+    const rep v1 = v10 + fy * (v11 - v10);
+    return v0 + fx * (v1 - v0);
+  }
+};
+
+}  // namespace tables
@@ -0,0 +1,98 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <system_error>
+#include <vector>
+#endif
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_FILE_MMAP 1
+#endif
+
+// Read-only view of a whole file; memory-mapped where available and read into memory otherwise
+//
+// In both cases the data is aligned at least to 8 bytes, so the files with properly aligned blocks can
+// be viewed as arrays of trivially copyable quantities in place.
+class mapped_file {
+public:
+  explicit mapped_file(const std::filesystem::path& path)
+  {
+#ifdef MAPPED_FILE_MMAP
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) throw std::filesystem::filesystem_error("cannot open", path, last_error());
+    struct stat st {};
+    ::fstat(fd_, &st);
+    size_ = static_cast<std::size_t>(st.st_size);
+    void* ptr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (ptr == MAP_FAILED) {
+      ::close(fd_);
+      throw std::filesystem::filesystem_error("cannot map", path, last_error());
+    }
+    data_ = static_cast<const std::byte*>(ptr);
+#else
+    std::ifstream file(path, std::ios::binary);
+    size_ = static_cast<std::size_t>(std::filesystem::file_size(path));
+    buffer_.resize((size_ + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+    file.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(size_));
+    data_ = reinterpret_cast<const std::byte*>(buffer_.data());
+#endif
+  }
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  ~mapped_file()
+  {
+#ifdef MAPPED_FILE_MMAP
+    ::munmap(const_cast<std::byte*>(data_), size_);
+    ::close(fd_);
+#endif
+  }
+
+  [[nodiscard]] std::span<const std::byte> bytes() const { return {data_, size_}; }
+
+private:
+  const std::byte* data_ = nullptr;
+  std::size_t size_ = 0;
+#ifdef MAPPED_FILE_MMAP
+  int fd_ = -1;
+
+  [[nodiscard]] static std::error_code last_error() { return {errno, std::generic_category()}; }
+#else
+  std::vector<std::uint64_t> buffer_;
+#endif
+};
@@ -0,0 +1,386 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/contracts.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/framework.h>
+#include <mp-units/systems/isq/base_quantities.h>
+#endif
+
+// Runge-Kutta integrators of ordinary differential equations over quantities
+//
+// A state is either a single quantity (with a scalar or a `cartesian_vector` representation type)
+// or a `std::tuple` of such quantities. A derivative function is invoked as `f(t, y)` where `t` is
+// the time elapsed since the start of the integration and `y` is the current state. It has to return
+// the derivative of the state with respect to time (a quantity or a tuple of quantities) which is checked
+// at compile time: every element multiplied by time has to be convertible to the corresponding element
+// of the state (e.g. a velocity for a position, a current for a charge).
+//
+// All the intermediate stages are kept on the stack so that the integration never allocates.
+
+namespace ode {
+
+namespace detail {
+
+template<typename T>
+struct tuple_of_quantities : std::false_type {};
+
+template<typename... Ts>
+struct tuple_of_quantities<std::tuple<Ts...>> :
+    std::bool_constant<(sizeof...(Ts) > 0) && (... && mp_units::Quantity<Ts>)> {};
+
+template<typename D, typename S, typename T>
+concept QuantityDerivativeOf = mp_units::Quantity<D> && mp_units::Quantity<S> &&
+                               (D::dimension * T::dimension == S::dimension) &&
+                               mp_units::explicitly_convertible(D::quantity_spec * T::quantity_spec, S::quantity_spec);
+
+template<typename D, typename S, typename T>
+inline constexpr bool is_derivative_of = QuantityDerivativeOf<D, S, T>;
+
+template<typename... Ds, typename... Ss, typename T>
+  requires(sizeof...(Ds) == sizeof...(Ss))
+inline constexpr bool is_derivative_of<std::tuple<Ds...>, std::tuple<Ss...>, T> =
+  (... && QuantityDerivativeOf<Ds, Ss, T>);
+
+// `y + h * sum(c[j] * k[j])` for a single quantity
+template<mp_units::Quantity S, mp_units::Quantity T, typename D, std::size_t M>
+[[nodiscard]] constexpr S advance(const S& y, T h, const std::array<double, M>& c, const std::array<D, M>& k)
+{
+  auto sum = c[0] * k[0];
+  for (std::size_t j = 1; j < M; ++j) sum += c[j] * k[j];
+  return S(y + mp_units::quantity_cast<S::quantity_spec>(sum * h).in(S::unit));
+}
+
+// `y + h * sum(c[j] * k[j])` applied to every element of a tuple
+template<typename... Ss, mp_units::Quantity T, typename... Ds, std::size_t M>
+[[nodiscard]] constexpr std::tuple<Ss...> advance(const std::tuple<Ss...>& y, T h, const std::array<double, M>& c,
+                                                  const std::array<std::tuple<Ds...>, M>& k)
+{
+  return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    return std::tuple<Ss...>{[&]<std::size_t I>(std::integral_constant<std::size_t, I>) {
+      using D = std::tuple_element_t<I, std::tuple<Ds...>>;
+      std::array<D, M> ki;
+      for (std::size_t j = 0; j < M; ++j) ki[j] = std::get<I>(k[j]);
+      return advance(std::get<I>(y), h, c, ki);
+    }(std::integral_constant<std::size_t, Is>{})...};
+  }(std::index_sequence_for<Ss...>{});
+}
+
+// numerical value of the length of a quantity expressed in the unit of `S`
+template<mp_units::Quantity S>
+[[nodiscard]] double norm_in(const S& q)
+{
+  const auto v = q.numerical_value_in(S::unit);
+  if constexpr (requires { v.magnitude(); })
+    return static_cast<double>(v.magnitude());
+  else
+    return static_cast<double>(std::abs(v));
+}
+
+// max over all the elements of `|err| / (abs_tol + rel_tol * max(|y0|, |y1|))`
+template<mp_units::Quantity S>
+[[nodiscard]] double error_ratio(const S& err, const S& y0, const S& y1, const S& abs_tol, double rel_tol)
+{
+  return norm_in(err) / (norm_in(abs_tol) + rel_tol * std::max(norm_in(y0), norm_in(y1)));
+}
+
+template<typename... Ss>
+[[nodiscard]] double error_ratio(const std::tuple<Ss...>& err, const std::tuple<Ss...>& y0,
+                                 const std::tuple<Ss...>& y1, const std::tuple<Ss...>& abs_tol, double rel_tol)
+{
+  return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    return std::max({error_ratio(std::get<Is>(err), std::get<Is>(y0), std::get<Is>(y1), std::get<Is>(abs_tol),
+                                 rel_tol)...});
+  }(std::index_sequence_for<Ss...>{});
+}
+
+template<mp_units::Quantity S>
+[[nodiscard]] constexpr S difference(const S& lhs, const S& rhs)
+{
+  return S(lhs - rhs);
+}
+
+template<typename... Ss>
+[[nodiscard]] constexpr std::tuple<Ss...> difference(const std::tuple<Ss...>& lhs, const std::tuple<Ss...>& rhs)
+{
+  return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    return std::tuple<Ss...>{difference(std::get<Is>(lhs), std::get<Is>(rhs))...};
+  }(std::index_sequence_for<Ss...>{});
+}
+
+}  // namespace detail
+
+template<typename S>
+concept State = mp_units::Quantity<S> || detail::tuple_of_quantities<S>::value;
+
+template<typename T>
+concept Time = mp_units::QuantityOf<T, mp_units::isq::time> && mp_units::treat_as_floating_point<typename T::rep>;
+
+template<typename F, typename S, typename T>
+concept DerivativeFunction =
+  State<S> && Time<T> && std::regular_invocable<F&, T, const S&> &&
+  detail::is_derivative_of<std::remove_cvref_t<std::invoke_result_t<F&, T, const S&>>, S, T>;
+
+struct no_observer {
+  template<typename T, typename S>
+  constexpr void operator()(const T&, const S&) const
+  {
+  }
+};
+
+/**
+ * @brief A single step of the classical 4th-order Runge-Kutta method
+ */
+template<State S, Time T, DerivativeFunction<S, T> F>
+[[nodiscard]] constexpr S rk4_step(F&& f, T t, const S& y, T h)
+{
+  using D = std::remove_cvref_t<std::invoke_result_t<F&, T, const S&>>;
+  using c1 = std::array<double, 1>;
+  const D k1 = f(t, y);
+  const D k2 = f(t + h / 2, detail::advance(y, h, c1{0.5}, std::array{k1}));
+  const D k3 = f(t + h / 2, detail::advance(y, h, c1{0.5}, std::array{k2}));
+  const D k4 = f(t + h, detail::advance(y, h, c1{1.}, std::array{k3}));
+  return detail::advance(y, h, std::array{1. / 6, 2. / 6, 2. / 6, 1. / 6}, std::array{k1, k2, k3, k4});
+}
+
+/**
+ * @brief Integrates the system from `t0` to `t_end` with a fixed step
+ *
+ * The last step is shortened if needed so that the integration ends exactly at `t_end`.
+ * `observer(t, y)` is invoked after every step.
+ */
+template<State S, Time T, DerivativeFunction<S, T> F, std::invocable<T, const S&> O = no_observer>
+constexpr S integrate_rk4(F&& f, S y, T t0, T t_end, T h, O&& observer = {})
+{
+  MP_UNITS_EXPECTS(h > T::zero());
+  for (T t = t0; t < t_end;) {
+    const T step = std::min(h, T(t_end - t));
+    y = rk4_step(f, t, y, step);
+    t += step;
+    observer(t, std::as_const(y));
+  }
+  return y;
+}
+
+template<State S, Time T>
+struct rk45_step_result {
+  S state;
+  S error;
+};
+
+/**
+ * @brief A single step of the Dormand-Prince 5(4) method
+ *
+ * @return 5th order solution and the difference from the embedded 4th order solution
+ */
+template<State S, Time T, DerivativeFunction<S, T> F>
+[[nodiscard]] constexpr rk45_step_result<S, T> rk45_step(F&& f, T t, const S& y, T h)
+{
+  using D = std::remove_cvref_t<std::invoke_result_t<F&, T, const S&>>;
+  const D k1 = f(t, y);
+  const D k2 = f(t + h * (1. / 5), detail::advance(y, h, std::array{1. / 5}, std::array{k1}));
+  const D k3 =
+    f(t + h * (3. / 10), detail::advance(y, h, std::array{3. / 40, 9. / 40}, std::array{k1, k2}));
+  const D k4 = f(t + h * (4. / 5),
+                 detail::advance(y, h, std::array{44. / 45, -56. / 15, 32. / 9}, std::array{k1, k2, k3}));
+  const D k5 = f(t + h * (8. / 9),
+                 detail::advance(y, h, std::array{19372. / 6561, -25360. / 2187, 64448. / 6561, -212. / 729},
+                                 std::array{k1, k2, k3, k4}));
+  const D k6 =
+    f(t + h, detail::advance(y, h, std::array{9017. / 3168, -355. / 33, 46732. / 5247, 49. / 176, -5103. / 18656},
+                             std::array{k1, k2, k3, k4, k5}));
+  constexpr std::array b5 = {35. / 384, 0., 500. / 1113, 125. / 192, -2187. / 6784, 11. / 84, 0.};
+  const S y5 = detail::advance(y, h, std::array{b5[0], b5[1], b5[2], b5[3], b5[4], b5[5]},
+                               std::array{k1, k2, k3, k4, k5, k6});
+  const D k7 = f(t + h, y5);
+  constexpr std::array b4 = {5179. / 57600, 0., 7571. / 16695, 393. / 640, -92097. / 339200, 187. / 2100, 1. / 40};
+  std::array<double, 7> e{};
+  for (std::size_t j = 0; j < e.size(); ++j) e[j] = b5[j] - b4[j];
+  const S zero_step = detail::difference(y, y);
+  return {y5, detail::advance(zero_step, h, e, std::array{k1, k2, k3, k4, k5, k6, k7})};
+}
+
+enum class rk45_status : std::uint8_t {
+  success,
+  step_too_small,  ///< the error could not be reduced below the tolerance with a step larger than the minimum one
+  too_many_steps,  ///< the maximum number of the attempted steps was reached before `t_end`
+  invalid_error    ///< the estimated error was not a finite number (e.g. the derivative returned NaN)
+};
+
+template<Time T>
+struct rk45_limits {
+  T h_min = T::zero();  ///< smallest allowed step; it is never smaller than what can still advance the time
+  std::size_t max_steps = 100'000;  ///< maximum number of the attempted (accepted and rejected) steps
+};
+
+template<State S, Time T>
+struct rk45_result {
+  S state;                   ///< the state at `time`
+  T time;                    ///< `t_end` on success or the time of the last accepted step otherwise
+  T step;                    ///< the step size to be used to continue the integration
+  rk45_status status;
+  std::size_t accepted = 0;  ///< number of the accepted steps
+  std::size_t rejected = 0;  ///< number of the rejected steps
+
+  [[nodiscard]] explicit operator bool() const { return status == rk45_status::success; }
+};
+
+/**
+ * @brief Integrates the system from `t0` to `t_end` with an adaptive step size
+ *
+ * The local error of every step is compared against `abs_tol + rel_tol * |y|` in the units of the state
+ * and the step is rejected and retried with a smaller size when it exceeds that limit.
+ * `observer(t, y)` is invoked after every accepted step.
+ *
+ * The integration stops early with an error status when the step would have to be smaller than
+ * `limits.h_min`, when `limits.max_steps` steps were attempted, or when the error estimate is not finite.
+ *
+ * @param h initial step size
+ */
+template<State S, Time T, DerivativeFunction<S, T> F, std::invocable<T, const S&> O = no_observer>
+rk45_result<S, T> integrate_rk45(F&& f, S y, T t0, T t_end, T h, const S& abs_tol, double rel_tol,
+                                 rk45_limits<T> limits = {}, O&& observer = {})
+{
+  MP_UNITS_EXPECTS(h > T::zero());
+  constexpr double safety = 0.9;
+  constexpr double min_factor = 0.2;
+  constexpr double max_factor = 5.;
+  using rep = T::rep;
+
+  // a step smaller than a few ulps of the time would not advance it
+  const rep time_scale =
+    std::max({std::abs(t0.numerical_value_in(T::unit)), std::abs(t_end.numerical_value_in(T::unit)), rep{1}});
+  const T h_min = std::max(limits.h_min, T(16 * std::numeric_limits<rep>::epsilon() * time_scale * T::reference));
+
+  rk45_result<S, T> res{y, t0, h, rk45_status::success};
+  while (res.time < t_end) {
+    if (res.accepted + res.rejected == limits.max_steps) {
+      res.status = rk45_status::too_many_steps;
+      break;
+    }
+    const bool last = res.step >= T(t_end - res.time);
+    const T step = last ? T(t_end - res.time) : res.step;
+    const auto [next, error] = rk45_step(f, res.time, res.state, step);
+    const double ratio = detail::error_ratio(error, res.state, next, abs_tol, rel_tol);
+    if (!std::isfinite(ratio)) {
+      res.status = rk45_status::invalid_error;
+      break;
+    }
+    const double factor =
+      ratio == 0 ? max_factor : std::clamp(safety * std::pow(ratio, -1. / 5), min_factor, max_factor);
+    if (ratio <= 1) {
+      ++res.accepted;
+      res.state = next;
+      res.time = last ? t_end : T(res.time + step);
+      observer(res.time, std::as_const(res.state));
+      // the shortened last step does not limit the step size used to continue the integration
+      if (!last) res.step = step * factor;
+    } else {
+      ++res.rejected;
+      res.step = step * factor;
+      if (res.step < h_min) {
+        res.status = rk45_status::step_too_small;
+        break;
+      }
+    }
+  }
+  return res;
+}
+
+/**
+ * @brief Integrates many independent systems sharing the same derivative function in parallel
+ *
+ * Every element of `states` is integrated in place with `integrate_rk4()`. The elements are split
+ * into contiguous chunks processed by `threads` worker threads.
+ */
+template<State S, Time T, DerivativeFunction<S, T> F>
+void integrate_rk4(const F& f, std::span<S> states, T t0, T t_end, T h,
+                   unsigned threads = std::thread::hardware_concurrency())
+{
+  const std::size_t workers = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(states.size(), 1));
+  const std::size_t chunk = (states.size() + workers - 1) / workers;
+  std::vector<std::jthread> pool;
+  pool.reserve(workers);
+  for (std::size_t w = 0; w < workers; ++w)
+    pool.emplace_back([&, begin = w * chunk] {
+      const std::size_t end = std::min(begin + chunk, states.size());
+      for (std::size_t i = begin; i < end; ++i) states[i] = integrate_rk4(f, states[i], t0, t_end, h);
+    });
+}
+
+/**
+ * @brief Integrates many independent systems sharing the same derivative function in parallel
+ *
+ * Every element of `states` is integrated in place with `integrate_rk45()` so each of them
+ * adapts its own step size. A state that failed to reach `t_end` is left at the time of its last
+ * accepted step.
+ *
+ * @return the status of the integration of every element of `states`
+ */
+template<State S, Time T, DerivativeFunction<S, T> F>
+std::vector<rk45_status> integrate_rk45(const F& f, std::span<S> states, T t0, T t_end, T h, const S& abs_tol,
+                                        double rel_tol, rk45_limits<T> limits = {},
+                                        unsigned threads = std::thread::hardware_concurrency())
+{
+  std::vector<rk45_status> res(states.size());
+  const std::size_t workers = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(states.size(), 1));
+  const std::size_t chunk = (states.size() + workers - 1) / workers;
+  {
+    std::vector<std::jthread> pool;
+    pool.reserve(workers);
+    for (std::size_t w = 0; w < workers; ++w)
+      pool.emplace_back([&, begin = w * chunk] {
+        const std::size_t end = std::min(begin + chunk, states.size());
+        for (std::size_t i = begin; i < end; ++i) {
+          const auto r = integrate_rk45(f, states[i], t0, t_end, h, abs_tol, rel_tol, limits);
+          states[i] = r.state;
+          res[i] = r.status;
+        }
+      });
+  }
+  return res;
+}
+
+}  // namespace ode
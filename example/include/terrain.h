@@ -0,0 +1,376 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "geographic.h"
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/contracts.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <numbers>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/framework.h>
+#include <mp-units/systems/isq/space_and_time.h>
+#include <mp-units/systems/si.h>
+#endif
+
+// A terrain elevation grid stored in tiles and sampled through an LRU cache of decoded tiles
+//
+// The file starts with a 64-byte header followed by square tiles of `tile_size x tile_size` samples in the
+// row-major order of tiles. Inside of a tile the samples are also stored row by row. Row `0` is the
+// southernmost one, column `0` is the westernmost one, and the edge tiles are padded by repeating the last
+// row and column. Every sample is a `terrain_sample`, i.e. a quantity point of an altitude above the mean
+// sea level in metres with a 16-bit representation, so a memory-mapped file can be viewed in place.
+// All the values are stored in the native byte order.
+//
+// A lookup decodes the whole tile into a cache that keeps the most recently used tiles. Every decoded tile
+// has an extra row and column copied from its northern and eastern neighbors, so the bilinear sampling
+// never crosses the tiles. Sequential samples (e.g. along a path) usually hit the most recently used tile,
+// which is checked before the hash lookup.
+
+namespace geographic {
+
+using terrain_sample =
+  mp_units::quantity_point<mp_units::isq::altitude[mp_units::si::metre], mean_sea_level, std::int16_t>;
+static_assert(sizeof(terrain_sample) == sizeof(std::int16_t) && std::is_trivially_copyable_v<terrain_sample>);
+
+struct terrain_grid_info {
+  mp_units::quantity<mp_units::si::degree> south;  // latitude of row `0`
+  mp_units::quantity<mp_units::si::degree> west;   // longitude of column `0`
+  mp_units::quantity<mp_units::si::degree> spacing;
+  std::uint32_t rows;
+  std::uint32_t cols;
+  std::uint32_t tile_size = 256;
+};
+
+namespace detail {
+
+inline constexpr std::array<char, 4> terrain_magic = {'M', 'P', 'U', 'T'};
+inline constexpr std::uint32_t terrain_version = 1;
+inline constexpr std::uint32_t terrain_max_tile_size = 4096;
+
+struct terrain_header {
+  std::array<char, 4> magic;
+  std::uint32_t version;
+  std::uint32_t rows;
+  std::uint32_t cols;
+  std::uint32_t tile_size;
+  std::uint32_t reserved;
+  double south_deg;
+  double west_deg;
+  double spacing_deg;
+  std::array<std::byte, 16> padding;
+};
+static_assert(sizeof(terrain_header) == 64);
+
+[[nodiscard]] constexpr std::size_t tile_count(std::size_t samples, std::size_t tile_size)
+{
+  return (samples + tile_size - 1) / tile_size;
+}
+
+[[nodiscard]] inline double degrees(mp_units::quantity<mp_units::si::degree> q) { return q.numerical_value_in(q.unit); }
+
+template<typename T>
+[[nodiscard]] double lat_deg(const position<T>& pos)
+{
+  return static_cast<double>(T(pos.lat.quantity_from_zero().numerical_value_in(mp_units::si::degree)));
+}
+
+template<typename T>
+[[nodiscard]] double lon_deg(const position<T>& pos)
+{
+  return static_cast<double>(T(pos.lon.quantity_from_zero().numerical_value_in(mp_units::si::degree)));
+}
+
+[[nodiscard]] inline msl_altitude make_msl_altitude(double metres)
+{
+  return msl_altitude{metres * mp_units::isq::altitude[mp_units::si::metre], mean_sea_level};
+}
+
+}  // namespace detail
+
+/**
+ * @brief Writes a terrain grid file
+ *
+ * @param samples all the samples of the grid in the row-major order starting from the south-western corner
+ */
+inline void write_terrain_grid(std::ostream& os, const terrain_grid_info& info, std::span<const terrain_sample> samples)
+{
+  MP_UNITS_EXPECTS(info.rows >= 2 && info.cols >= 2);
+  MP_UNITS_EXPECTS(info.tile_size > 0 && info.tile_size <= detail::terrain_max_tile_size);
+  MP_UNITS_EXPECTS(samples.size() == std::size_t{info.rows} * info.cols);
+
+  const detail::terrain_header header{detail::terrain_magic,
+                                      detail::terrain_version,
+                                      info.rows,
+                                      info.cols,
+                                      info.tile_size,
+                                      0,
+                                      detail::degrees(info.south),
+                                      detail::degrees(info.west),
+                                      detail::degrees(info.spacing),
+                                      {}};
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  const std::size_t size = info.tile_size;
+  std::vector<terrain_sample> row(size);
+  for (std::size_t ty = 0; ty < detail::tile_count(info.rows, size); ++ty)
+    for (std::size_t tx = 0; tx < detail::tile_count(info.cols, size); ++tx)
+      for (std::size_t r = 0; r < size; ++r) {
+        const std::size_t grid_row = std::min<std::size_t>(ty * size + r, info.rows - 1);
+        for (std::size_t c = 0; c < size; ++c)
+          row[c] = samples[grid_row * info.cols + std::min<std::size_t>(tx * size + c, info.cols - 1)];
+        os.write(reinterpret_cast<const char*>(row.data()),
+                 static_cast<std::streamsize>(size * sizeof(terrain_sample)));
+      }
+}
+
+/**
+ * @brief A read-only view of the terrain grid file contents (e.g. a memory-mapped file)
+ *
+ * @throws std::invalid_argument if the header is not valid or the data is truncated
+ */
+class terrain_grid {
+public:
+  explicit terrain_grid(std::span<const std::byte> bytes)
+  {
+    detail::terrain_header header{};
+    if (bytes.size() < sizeof(header)) throw std::invalid_argument("truncated terrain grid");
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != detail::terrain_magic || header.version != detail::terrain_version)
+      throw std::invalid_argument("not a terrain grid");
+    if (header.rows < 2 || header.cols < 2 || header.tile_size == 0 ||
+        header.tile_size > detail::terrain_max_tile_size || !(header.spacing_deg > 0))
+      throw std::invalid_argument("invalid terrain grid header");
+    using namespace mp_units::si::unit_symbols;
+    info_ = {header.south_deg * deg, header.west_deg * deg, header.spacing_deg * deg, header.rows, header.cols,
+             header.tile_size};
+    tiles_y_ = detail::tile_count(info_.rows, info_.tile_size);
+    tiles_x_ = detail::tile_count(info_.cols, info_.tile_size);
+    // the sizes come from the file so the products are checked against the available data before computing them
+    const std::size_t tile_samples = std::size_t{info_.tile_size} * info_.tile_size;
+    const std::size_t available_tiles = (bytes.size() - sizeof(header)) / (tile_samples * sizeof(terrain_sample));
+    if (tiles_y_ > available_tiles / tiles_x_) throw std::invalid_argument("truncated terrain grid");
+    const std::size_t count = tiles_y_ * tiles_x_ * tile_samples;
+    samples_ = {reinterpret_cast<const terrain_sample*>(bytes.data() + sizeof(header)), count};
+  }
+
+  [[nodiscard]] const terrain_grid_info& info() const { return info_; }
+  [[nodiscard]] std::size_t tiles_y() const { return tiles_y_; }
+  [[nodiscard]] std::size_t tiles_x() const { return tiles_x_; }
+
+  [[nodiscard]] std::span<const terrain_sample> tile(std::size_t ty, std::size_t tx) const
+  {
+    MP_UNITS_EXPECTS(ty < tiles_y_ && tx < tiles_x_);
+    const std::size_t size = std::size_t{info_.tile_size} * info_.tile_size;
+    return samples_.subspan((ty * tiles_x_ + tx) * size, size);
+  }
+
+  [[nodiscard]] terrain_sample at(std::size_t row, std::size_t col) const
+  {
+    MP_UNITS_EXPECTS(row < info_.rows && col < info_.cols);
+    const std::size_t size = info_.tile_size;
+    return tile(row / size, col / size)[(row % size) * size + col % size];
+  }
+
+private:
+  terrain_grid_info info_{};
+  std::size_t tiles_y_ = 0;
+  std::size_t tiles_x_ = 0;
+  std::span<const terrain_sample> samples_;
+};
+
+/**
+ * @brief Bilinear sampling of a terrain grid through a cache of the least recently used decoded tiles
+ *
+ * The positions outside of the grid are clamped to its edges. The cache is not thread-safe; every thread
+ * should use its own one.
+ */
+class terrain_cache {
+public:
+  terrain_cache(const terrain_grid& grid, std::size_t capacity) :
+      grid_(&grid),
+      south_(detail::degrees(grid.info().south)),
+      west_(detail::degrees(grid.info().west)),
+      inv_spacing_(1. / detail::degrees(grid.info().spacing)),
+      capacity_(capacity)
+  {
+    MP_UNITS_EXPECTS(capacity > 0);
+  }
+
+  [[nodiscard]] const terrain_grid& grid() const { return *grid_; }
+  [[nodiscard]] std::size_t size() const { return tiles_.size(); }
+  [[nodiscard]] std::size_t capacity() const { return capacity_; }
+  [[nodiscard]] std::size_t hits() const { return hits_; }
+  [[nodiscard]] std::size_t misses() const { return misses_; }
+
+  template<typename T>
+  [[nodiscard]] msl_altitude sample(const position<T>& pos)
+  {
+    return detail::make_msl_altitude(sample_deg(detail::lat_deg(pos), detail::lon_deg(pos)));
+  }
+
+  /**
+   * @brief Samples the terrain at many positions
+   */
+  template<typename T>
+  void sample(std::span<const position<T>> positions, std::span<msl_altitude> out)
+  {
+    MP_UNITS_EXPECTS(positions.size() == out.size());
+    for (std::size_t i = 0; i < positions.size(); ++i) out[i] = sample(positions[i]);
+  }
+
+  /**
+   * @brief Samples the terrain profile along the great circle from `from` to `to`
+   *
+   * `out.size()` samples are equally spaced along the path and include both of its ends.
+   */
+  template<typename T>
+  void profile(const position<T>& from, const position<T>& to, std::span<msl_altitude> out)
+  {
+    constexpr double to_rad = std::numbers::pi / 180.;
+    const double lat1 = detail::lat_deg(from) * to_rad, lon1 = detail::lon_deg(from) * to_rad;
+    const double lat2 = detail::lat_deg(to) * to_rad, lon2 = detail::lon_deg(to) * to_rad;
+
+    // unit vectors of both ends and the central angle between them
+    const std::array<double, 3> p1 = {std::cos(lat1) * std::cos(lon1), std::cos(lat1) * std::sin(lon1), std::sin(lat1)};
+    const std::array<double, 3> p2 = {std::cos(lat2) * std::cos(lon2), std::cos(lat2) * std::sin(lon2), std::sin(lat2)};
+    const double angle = std::acos(std::clamp(p1[0] * p2[0] + p1[1] * p2[1] + p1[2] * p2[2], -1., 1.));
+    const double sin_angle = std::sin(angle);
+
+    const std::size_t n = out.size();
+    for (std::size_t i = 0; i < n; ++i) {
+      const double f = n == 1 ? 0. : static_cast<double>(i) / static_cast<double>(n - 1);
+      // spherical linear interpolation degenerates to the linear one for very close ends
+      const double a = sin_angle < 1e-12 ? 1. - f : std::sin((1. - f) * angle) / sin_angle;
+      const double b = sin_angle < 1e-12 ? f : std::sin(f * angle) / sin_angle;
+      const double x = a * p1[0] + b * p2[0], y = a * p1[1] + b * p2[1], z = a * p1[2] + b * p2[2];
+      const double lat = std::atan2(z, std::hypot(x, y)) / to_rad;
+      const double lon = std::atan2(y, x) / to_rad;
+      out[i] = detail::make_msl_altitude(sample_deg(lat, lon));
+    }
+  }
+
+private:
+  struct tile {
+    std::size_t key;
+    std::vector<float> heights;  // `(tile_size + 1)^2` heights in metres
+  };
+
+  const terrain_grid* grid_;
+  double south_;
+  double west_;
+  double inv_spacing_;
+  std::size_t capacity_;
+  std::list<tile> tiles_;  // from the most to the least recently used
+  std::unordered_map<std::size_t, std::list<tile>::iterator> index_;
+  std::size_t hits_ = 0;
+  std::size_t misses_ = 0;
+
+  [[nodiscard]] double sample_deg(double lat, double lon)
+  {
+    const terrain_grid_info& info = grid_->info();
+    const double y = std::clamp((lat - south_) * inv_spacing_, 0., static_cast<double>(info.rows - 1));
+    const double x = std::clamp((lon - west_) * inv_spacing_, 0., static_cast<double>(info.cols - 1));
+    const std::size_t row = std::min(static_cast<std::size_t>(y), std::size_t{info.rows} - 2);
+    const std::size_t col = std::min(static_cast<std::size_t>(x), std::size_t{info.cols} - 2);
+    const double fy = y - static_cast<double>(row);
+    const double fx = x - static_cast<double>(col);
+
+    const std::size_t size = info.tile_size;
+    const tile& t = get(row / size, col / size);
+    const std::size_t stride = size + 1;
+    const float* h = t.heights.data() + (row % size) * stride + col % size;
+    const double h00 = static_cast<double>(h[0]), h01 = static_cast<double>(h[1]);
+    const double h10 = static_cast<double>(h[stride]), h11 = static_cast<double>(h[stride + 1]);
+    const double h0 = h00 + fx * (h01 - h00);
+    const double h1 = h10 + fx * (h11 - h10);
+    return h0 + fy * (h1 - h0);
+  }
+
+  [[nodiscard]] const tile& get(std::size_t ty, std::size_t tx)
+  {
+    const std::size_t key = ty * grid_->tiles_x() + tx;
+    if (!tiles_.empty() && tiles_.front().key == key) {
+      ++hits_;
+      return tiles_.front();
+    }
+    if (const auto it = index_.find(key); it != index_.end()) {
+      ++hits_;
+      tiles_.splice(tiles_.begin(), tiles_, it->second);
+      return tiles_.front();
+    }
+    ++misses_;
+    if (tiles_.size() == capacity_) {
+      // reuse the storage of the evicted tile
+      index_.erase(tiles_.back().key);
+      tiles_.splice(tiles_.begin(), tiles_, std::prev(tiles_.end()));
+    } else
+      tiles_.emplace_front();
+    tile& t = tiles_.front();
+    t.key = key;
+    decode(ty, tx, t.heights);
+    index_.emplace(key, tiles_.begin());
+    return t;
+  }
+
+  void decode(std::size_t ty, std::size_t tx, std::vector<float>& heights) const
+  {
+    const terrain_grid_info& info = grid_->info();
+    const std::size_t size = info.tile_size;
+    const std::size_t stride = size + 1;
+    heights.resize(stride * stride);
+    const std::span<const terrain_sample> samples = grid_->tile(ty, tx);
+    auto metres = [](terrain_sample s) {
+      return static_cast<float>(s.quantity_ref_from(mean_sea_level).numerical_value_ref_in(mp_units::si::metre));
+    };
+    for (std::size_t r = 0; r < size; ++r)
+      for (std::size_t c = 0; c < size; ++c) heights[r * stride + c] = metres(samples[r * size + c]);
+    // the apron from the northern and eastern neighbors (clamped at the edges of the grid)
+    const std::size_t north = std::min<std::size_t>((ty + 1) * size, info.rows - 1);
+    const std::size_t east = std::min<std::size_t>((tx + 1) * size, info.cols - 1);
+    for (std::size_t c = 0; c <= size; ++c)
+      heights[size * stride + c] = metres(grid_->at(north, std::min<std::size_t>(tx * size + c, info.cols - 1)));
+    for (std::size_t r = 0; r < size; ++r)
+      heights[r * stride + size] = metres(grid_->at(std::min<std::size_t>(ty * size + r, info.rows - 1), east));
+  }
+};
+
+}  // namespace geographic
@@ -0,0 +1,221 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/contracts.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/si/chrono.h>
+#endif
+
+// Scoped timing probes
+//
+// `scoped_timer` reads a clock with `mp_units::now<Clock>()` on construction and destruction and delivers
+// the elapsed time to a sink as `probes::duration`, so the measurements can never be confused with raw
+// numbers in other units. Defining `TIMING_PROBES_DISABLED` compiles the timers out while keeping the
+// instrumented code unchanged.
+
+namespace probes {
+
+using duration = mp_units::quantity<mp_units::si::nano<mp_units::si::second>, std::int64_t>;
+
+template<typename T>
+concept Sink = requires(T& sink, duration d) { sink.record(d); };
+
+/**
+ * @brief Measures the lifetime of a scope and records it in a sink
+ *
+ * @tparam S sink receiving the elapsed time
+ * @tparam Clock clock satisfying the requirements of `mp_units::now()`
+ */
+template<Sink S, typename Clock = std::chrono::steady_clock>
+class scoped_timer {
+public:
+#ifdef TIMING_PROBES_DISABLED
+  explicit scoped_timer(S&) noexcept {}
+
+  [[nodiscard]] duration elapsed() const noexcept { return duration::zero(); }
+#else
+  explicit scoped_timer(S& sink) noexcept : sink_(sink), start_(mp_units::now<Clock>()) {}
+  ~scoped_timer() { sink_.record(elapsed()); }
+
+  [[nodiscard]] duration elapsed() const
+  {
+    return (mp_units::now<Clock>() - start_).template force_in<std::int64_t>(duration::unit);
+  }
+#endif
+
+  scoped_timer(const scoped_timer&) = delete;
+  scoped_timer& operator=(const scoped_timer&) = delete;
+
+#ifndef TIMING_PROBES_DISABLED
+private:
+  S& sink_;
+  decltype(mp_units::now<Clock>()) start_;
+#endif
+};
+
+/**
+ * @brief Number and total duration of the measurements
+ */
+class counter {
+public:
+  void record(duration d) noexcept
+  {
+    count_.fetch_add(1, std::memory_order_relaxed);
+    total_.fetch_add(d.numerical_value_in(duration::unit), std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] std::uint64_t count() const noexcept { return count_.load(std::memory_order_relaxed); }
+  [[nodiscard]] duration total() const noexcept { return total_.load(std::memory_order_relaxed) * duration::reference; }
+
+  [[nodiscard]] duration mean() const noexcept
+  {
+    const std::uint64_t n = count();
+    return n == 0 ? duration::zero() : total() / static_cast<std::int64_t>(n);
+  }
+
+private:
+  std::atomic<std::uint64_t> count_{0};
+  std::atomic<std::int64_t> total_{0};
+};
+
+/**
+ * @brief Latency histogram with power-of-two buckets of nanoseconds
+ *
+ * The bucket `i` counts the measurements in the range `[2^(i-1), 2^i)` ns (the bucket `0` counts the ones
+ * shorter than 1 ns), so any latency is covered by only 64 counters and the quantiles are accurate
+ * within a factor of two.
+ */
+class histogram {
+public:
+  static constexpr std::size_t bucket_count = 64;
+
+  void record(duration d) noexcept
+  {
+    const auto ns = static_cast<std::uint64_t>(std::max<std::int64_t>(d.numerical_value_in(duration::unit), 0));
+    buckets_[std::min<std::size_t>(std::bit_width(ns), bucket_count - 1)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] std::uint64_t count() const noexcept
+  {
+    std::uint64_t n = 0;
+    for (const auto& b : buckets_) n += b.load(std::memory_order_relaxed);
+    return n;
+  }
+
+  /**
+   * @brief Upper bound of the bucket containing the `q` quantile of the measurements
+   *
+   * Returns zero if nothing was recorded.
+   */
+  [[nodiscard]] duration quantile(double q) const noexcept
+  {
+    MP_UNITS_EXPECTS(q >= 0 && q <= 1);
+    const std::uint64_t n = count();
+    if (n == 0) return duration::zero();
+    const auto rank = std::min(static_cast<std::uint64_t>(q * static_cast<double>(n)), n - 1);
+    std::uint64_t seen = 0;
+    std::size_t i = 0;
+    for (; i < bucket_count - 1; ++i) {
+      seen += buckets_[i].load(std::memory_order_relaxed);
+      if (seen > rank) break;
+    }
+    // the upper bound of the last bucket is not representable
+    if (i == bucket_count - 1) return std::numeric_limits<std::int64_t>::max() * duration::reference;
+    return static_cast<std::int64_t>(std::uint64_t{1} << i) * duration::reference;
+  }
+
+private:
+  std::array<std::atomic<std::uint64_t>, bucket_count> buckets_{};
+};
+
+/**
+ * @brief Lock-free buffer of the last measurements of a single thread
+ *
+ * One thread records the measurements and another one may drain them concurrently. When the consumer
+ * does not keep up, the oldest measurements are overwritten and counted as dropped.
+ *
+ * @tparam Capacity number of the stored measurements (a power of two)
+ */
+template<std::size_t Capacity>
+  requires(std::has_single_bit(Capacity))
+class ring_buffer {
+public:
+  void record(duration d) noexcept
+  {
+    const std::uint64_t head = head_.load(std::memory_order_relaxed);
+    claimed_.store(head + 1, std::memory_order_relaxed);
+    // pairs with the acquire fence in `drain()`: a reader that sees the new value also sees the claim
+    std::atomic_thread_fence(std::memory_order_release);
+    slots_[head % Capacity].store(d.numerical_value_in(duration::unit), std::memory_order_relaxed);
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Calls `f` with every measurement recorded since the previous call
+   *
+   * @return number of the measurements lost since the previous call
+   */
+  template<std::invocable<duration> F>
+  std::uint64_t drain(F&& f)
+  {
+    const std::uint64_t head = head_.load(std::memory_order_acquire);
+    std::uint64_t dropped = head - tail_ > Capacity ? head - tail_ - Capacity : 0;
+    for (std::uint64_t i = tail_ + dropped; i < head; ++i) {
+      const std::int64_t value = slots_[i % Capacity].load(std::memory_order_relaxed);
+      // the slot may have been overwritten by the producer while it was read; the record that overwrites
+      // slot `i` claims the index `i + Capacity` before it writes the slot
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (claimed_.load(std::memory_order_relaxed) - i > Capacity) {
+        ++dropped;
+        continue;
+      }
+      f(value * duration::reference);
+    }
+    tail_ = head;
+    return dropped;
+  }
+
+private:
+  std::array<std::atomic<std::int64_t>, Capacity> slots_{};
+  std::atomic<std::uint64_t> head_{0};
+  std::atomic<std::uint64_t> claimed_{0};  // `head_` of the record in progress plus one
+  std::uint64_t tail_ = 0;
+};
+
+}  // namespace probes
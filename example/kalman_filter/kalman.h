@@ -23,13 +23,21 @@
 #pragma once
 
 #include <mp-units/compat_macros.h>
+#include <mp-units/ext/contracts.h>
 #include <mp-units/ext/format.h>
 #ifdef MP_UNITS_IMPORT_STD
 import std;
 #else
 #include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
 #include <locale>
+#include <ranges>
+#include <span>
 #include <tuple>
+#include <utility>
+#include <vector>
 #endif
 #ifdef MP_UNITS_MODULES
 import mp_units;
@@ -190,6 +198,141 @@ template<mp_units::Quantity Q1, mp_units::Quantity Q2>
   return uncertainty + process_noise_variance;
 }
 
+// batch processing of many independent tracks
+//
+// The states of all the tracks are stored as a structure of arrays (one contiguous array per state
+// variable) and every step processes all the tracks in a single loop over those arrays. Each track
+// has its own measurement and gain but all of them share the same types and interval.
+
+namespace detail {
+
+template<typename R, auto QS>
+concept QuantityRangeOf = std::ranges::random_access_range<R> && std::ranges::sized_range<R> &&
+                          mp_units::QuantityOf<std::ranges::range_value_t<R>, QS>;
+
+template<typename R>
+concept QuantityPointRange = std::ranges::random_access_range<R> && std::ranges::sized_range<R> &&
+                             mp_units::QuantityPoint<std::ranges::range_value_t<R>>;
+
+}  // namespace detail
+
+template<mp_units::QuantityPoint... QPs>
+  requires requires { typename system_state<QPs...>; }
+class system_state_batch {
+  std::tuple<std::vector<QPs>...> variables_;
+public:
+  constexpr system_state_batch(std::size_t size, const system_state<QPs...>& initial)
+  {
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      (std::get<Is>(variables_).assign(size, get<Is>(initial)), ...);
+    }(std::index_sequence_for<QPs...>{});
+  }
+
+  [[nodiscard]] constexpr std::size_t size() const { return std::get<0>(variables_).size(); }
+
+  [[nodiscard]] constexpr system_state<QPs...> operator[](std::size_t idx) const
+  {
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      return system_state<QPs...>{std::get<Is>(variables_)[idx]...};
+    }(std::index_sequence_for<QPs...>{});
+  }
+
+  constexpr void set(std::size_t idx, const system_state<QPs...>& s)
+  {
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      ((std::get<Is>(variables_)[idx] = get<Is>(s)), ...);
+    }(std::index_sequence_for<QPs...>{});
+  }
+
+  template<std::size_t Idx>
+  [[nodiscard]] friend constexpr std::span<std::tuple_element_t<Idx, std::tuple<QPs...>>> get(system_state_batch& s)
+  {
+    return std::get<Idx>(s.variables_);
+  }
+
+  template<std::size_t Idx>
+  [[nodiscard]] friend constexpr std::span<const std::tuple_element_t<Idx, std::tuple<QPs...>>> get(
+    const system_state_batch& s)
+  {
+    return std::get<Idx>(s.variables_);
+  }
+};
+
+// kalman gain
+template<detail::QuantityRangeOf<mp_units::dimensionless> G, typename V1, typename V2>
+  requires std::ranges::random_access_range<V1> && std::ranges::sized_range<V1> &&
+           std::ranges::random_access_range<V2> && std::ranges::sized_range<V2> &&
+           requires(std::ranges::range_value_t<V1> v1, std::ranges::range_value_t<V2> v2) {
+             { kalman_gain(v1, v2) } -> std::convertible_to<std::ranges::range_value_t<G>>;
+           }
+constexpr void kalman_gain(const V1& variance_in_estimate, const V2& variance_in_measurement, G&& gain)
+{
+  MP_UNITS_EXPECTS(std::ranges::size(variance_in_estimate) == std::ranges::size(gain));
+  MP_UNITS_EXPECTS(std::ranges::size(variance_in_measurement) == std::ranges::size(gain));
+  const auto n = std::ranges::size(gain);
+  for (std::size_t i = 0; i < n; ++i) gain[i] = kalman_gain(variance_in_estimate[i], variance_in_measurement[i]);
+}
+
+// state update
+template<typename QP, detail::QuantityPointRange M, detail::QuantityRangeOf<mp_units::dimensionless> K>
+  requires(implicitly_convertible(std::ranges::range_value_t<M>::quantity_spec, QP::quantity_spec))
+constexpr void state_update(system_state_batch<QP>& state, const M& measured, const K& gain)
+{
+  const std::span x = get<0>(state);
+  MP_UNITS_EXPECTS(std::ranges::size(measured) == x.size());
+  MP_UNITS_EXPECTS(std::ranges::size(gain) == x.size());
+  for (std::size_t i = 0; i < x.size(); ++i) x[i] = fma(gain[i], measured[i] - x[i], x[i]);
+}
+
+template<typename QP1, typename QP2, detail::QuantityPointRange M, detail::QuantityRangeOf<mp_units::dimensionless> K,
+         mp_units::QuantityOf<mp_units::isq::time> T>
+  requires(implicitly_convertible(std::ranges::range_value_t<M>::quantity_spec, QP1::quantity_spec))
+constexpr void state_update(system_state_batch<QP1, QP2>& state, const M& measured, const std::array<K, 2>& gain,
+                            T interval)
+{
+  const std::span x1 = get<0>(state);
+  const std::span x2 = get<1>(state);
+  MP_UNITS_EXPECTS(std::ranges::size(measured) == x1.size());
+  MP_UNITS_EXPECTS(std::ranges::size(get<0>(gain)) == x1.size() && std::ranges::size(get<1>(gain)) == x1.size());
+  for (std::size_t i = 0; i < x1.size(); ++i) {
+    const auto residual = measured[i] - x1[i];
+    x1[i] = fma(get<0>(gain)[i], residual, x1[i]);
+    x2[i] = fma(get<1>(gain)[i], residual / interval, x2[i]);
+  }
+}
+
+template<typename QP1, typename QP2, typename QP3, detail::QuantityPointRange M,
+         detail::QuantityRangeOf<mp_units::dimensionless> K, mp_units::QuantityOf<mp_units::isq::time> T>
+  requires(implicitly_convertible(std::ranges::range_value_t<M>::quantity_spec, QP1::quantity_spec))
+constexpr void state_update(system_state_batch<QP1, QP2, QP3>& state, const M& measured,
+                            const std::array<K, 3>& gain, T interval)
+{
+  const std::span x1 = get<0>(state);
+  const std::span x2 = get<1>(state);
+  const std::span x3 = get<2>(state);
+  MP_UNITS_EXPECTS(std::ranges::size(measured) == x1.size());
+  MP_UNITS_EXPECTS(std::ranges::size(get<0>(gain)) == x1.size() && std::ranges::size(get<1>(gain)) == x1.size() &&
+                   std::ranges::size(get<2>(gain)) == x1.size());
+  const auto half_interval_sq = interval * interval / 2;
+  for (std::size_t i = 0; i < x1.size(); ++i) {
+    const auto residual = measured[i] - x1[i];
+    x1[i] = fma(get<0>(gain)[i], residual, x1[i]);
+    x2[i] = fma(get<1>(gain)[i], residual / interval, x2[i]);
+    x3[i] = fma(get<2>(gain)[i], residual / half_interval_sq, x3[i]);
+  }
+}
+
+// covariance update
+template<typename U, detail::QuantityRangeOf<mp_units::dimensionless> K>
+  requires std::ranges::random_access_range<U> && std::ranges::sized_range<U> &&
+           mp_units::Quantity<std::ranges::range_value_t<U>>
+constexpr void covariance_update(U&& uncertainty, const K& gain)
+{
+  MP_UNITS_EXPECTS(std::ranges::size(uncertainty) == std::ranges::size(gain));
+  const auto n = std::ranges::size(uncertainty);
+  for (std::size_t i = 0; i < n; ++i) uncertainty[i] = covariance_update(uncertainty[i], gain[i]);
+}
+
 }  // namespace kalman
 
 template<auto R, auto PO, typename Rep, typename Char>
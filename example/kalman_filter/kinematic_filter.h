@@ -0,0 +1,223 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/framework/quantity.h>
+#include <mp-units/math.h>
+#include <mp-units/systems/isq/base_quantities.h>
+#endif
+
+// A multi-state Kalman filter in the matrix form
+//
+// The state vector holds a quantity and its `N - 1` consecutive time derivatives (e.g. position, velocity,
+// and acceleration) and the covariance matrix holds their variances and covariances. The references of all
+// the elements are derived at compile time from the reference of the first state and the time reference
+// (e.g. `m`, `m/s`, `m/s²` for the state and `m²`, `m²/s`, ..., `m²/s⁴` for the covariance matrix).
+//
+// Since all of those references are built from the same units, the numerical values of the elements are
+// consistent with each other and can be stored as plain fixed-size arrays of `Rep`. The unit safety is
+// enforced at the interface of the filter while the predict and update steps run over those arrays in
+// loops with compile-time bounds that the compiler fully unrolls and vectorizes. No dynamic memory
+// is used.
+//
+// The model assumes:
+// - a constant highest-order derivative between the steps (state transition matrix with `dt^k/k!` terms),
+// - discrete white noise on the highest-order derivative as the process noise,
+// - a direct measurement of the first state.
+
+namespace kalman {
+
+namespace detail {
+
+using mp_units::pow;
+
+// reference of the `I`-th time derivative of a quantity of reference `R`
+template<mp_units::Reference auto R, mp_units::Reference auto TR, std::size_t I>
+constexpr mp_units::Reference auto derivative_reference = R / pow<I>(TR);
+
+// reference of the covariance of the `I`-th and `J`-th time derivatives
+template<mp_units::Reference auto R, mp_units::Reference auto TR, std::size_t I, std::size_t J>
+constexpr mp_units::Reference auto covariance_reference = pow<2>(R) / pow<I + J>(TR);
+
+}  // namespace detail
+
+template<mp_units::Reference auto R, mp_units::ReferenceOf<mp_units::isq::time> auto TR, std::size_t N,
+         mp_units::RepresentationOf<get_quantity_spec(R)> Rep = double>
+  requires(N > 0)
+class kinematic_filter {
+public:
+  template<std::size_t I>
+    requires(I < N)
+  using state_type = mp_units::quantity<detail::derivative_reference<R, TR, I>, Rep>;
+
+  template<std::size_t I, std::size_t J>
+    requires(I < N) && (J < N)
+  using covariance_type = mp_units::quantity<detail::covariance_reference<R, TR, I, J>, Rep>;
+
+  template<std::size_t I>
+    requires(I < N)
+  using gain_type = mp_units::quantity<detail::derivative_reference<R, TR, I> / R, Rep>;
+
+  using interval_type = mp_units::quantity<TR, Rep>;
+  using measurement_type = state_type<0>;
+  using measurement_variance_type = covariance_type<0, 0>;
+  using process_noise_variance_type = covariance_type<N - 1, N - 1>;
+
+  static constexpr std::size_t size = N;
+
+  kinematic_filter() = default;
+
+  /**
+   * @brief Initializes the filter with the initial state and the diagonal of its covariance matrix
+   *
+   * @param state the initial values of the state starting from the lowest derivative
+   * @param variance the initial variances of the state starting from the lowest derivative
+   */
+  template<typename... Qs, typename... Vs>
+    requires(sizeof...(Qs) == N) && (sizeof...(Vs) == N)
+  constexpr kinematic_filter(const std::tuple<Qs...>& state, const std::tuple<Vs...>& variance)
+  {
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      (set_state<Is>(std::get<Is>(state)), ...);
+      (set_covariance<Is, Is>(std::get<Is>(variance)), ...);
+    }(std::make_index_sequence<N>{});
+  }
+
+  template<std::size_t I>
+    requires(I < N)
+  [[nodiscard]] constexpr state_type<I> state() const
+  {
+    return x_[I] * state_type<I>::reference;
+  }
+
+  template<std::size_t I>
+    requires(I < N)
+  constexpr void set_state(state_type<I> q)
+  {
+    x_[I] = q.numerical_value_in(state_type<I>::unit);
+  }
+
+  template<std::size_t I, std::size_t J>
+    requires(I < N) && (J < N)
+  [[nodiscard]] constexpr covariance_type<I, J> covariance() const
+  {
+    return p_[I * N + J] * covariance_type<I, J>::reference;
+  }
+
+  template<std::size_t I, std::size_t J>
+    requires(I < N) && (J < N)
+  constexpr void set_covariance(covariance_type<I, J> q)
+  {
+    p_[I * N + J] = p_[J * N + I] = q.numerical_value_in(covariance_type<I, J>::unit);
+  }
+
+  /**
+   * @brief Kalman gain computed by the last update step
+   */
+  template<std::size_t I>
+    requires(I < N)
+  [[nodiscard]] constexpr gain_type<I> gain() const
+  {
+    return k_[I] * gain_type<I>::reference;
+  }
+
+  /**
+   * @brief State and covariance extrapolation
+   *
+   * x = F * x
+   * P = F * P * F^T + Q
+   */
+  constexpr void predict(interval_type interval, process_noise_variance_type process_noise_variance)
+  {
+    const Rep dt = interval.numerical_value_in(interval_type::unit);
+
+    // dt^k / k!
+    std::array<Rep, N> terms{};
+    terms[0] = Rep{1};
+    for (std::size_t k = 1; k < N; ++k) terms[k] = terms[k - 1] * dt / static_cast<Rep>(k);
+
+    // F is upper triangular with `F[i][j] == terms[j - i]`
+    std::array<Rep, N> x{};
+    for (std::size_t i = 0; i < N; ++i)
+      for (std::size_t j = i; j < N; ++j) x[i] += terms[j - i] * x_[j];
+    x_ = x;
+
+    // F * P
+    std::array<Rep, N * N> fp{};
+    for (std::size_t i = 0; i < N; ++i)
+      for (std::size_t k = i; k < N; ++k)
+        for (std::size_t j = 0; j < N; ++j) fp[i * N + j] += terms[k - i] * p_[k * N + j];
+
+    // (F * P) * F^T + Q where `Q = G * G^T * q` and `G[i] == terms[N - 1 - i]`
+    const Rep q = process_noise_variance.numerical_value_in(process_noise_variance_type::unit);
+    for (std::size_t i = 0; i < N; ++i)
+      for (std::size_t j = 0; j < N; ++j) {
+        Rep sum = terms[N - 1 - i] * terms[N - 1 - j] * q;
+        for (std::size_t k = j; k < N; ++k) sum += fp[i * N + k] * terms[k - j];
+        p_[i * N + j] = sum;
+      }
+  }
+
+  /**
+   * @brief State and covariance update with a measurement of the first state
+   *
+   * K = P * H^T / (H * P * H^T + r)
+   * x = x + K * (z - H * x)
+   * P = (I - K * H) * P
+   */
+  constexpr void update(measurement_type measurement, measurement_variance_type measurement_variance)
+  {
+    const Rep z = measurement.numerical_value_in(measurement_type::unit);
+    const Rep r = measurement_variance.numerical_value_in(measurement_variance_type::unit);
+
+    const Rep s = p_[0] + r;
+    for (std::size_t i = 0; i < N; ++i) k_[i] = p_[i * N] / s;
+
+    const Rep innovation = z - x_[0];
+    for (std::size_t i = 0; i < N; ++i) x_[i] += k_[i] * innovation;
+
+    std::array<Rep, N> first_row{};
+    for (std::size_t j = 0; j < N; ++j) first_row[j] = p_[j];
+    for (std::size_t i = 0; i < N; ++i)
+      for (std::size_t j = 0; j < N; ++j) p_[i * N + j] -= k_[i] * first_row[j];
+  }
+
+private:
+  std::array<Rep, N> x_{};
+  std::array<Rep, N * N> p_{};
+  std::array<Rep, N> k_{};
+};
+
+}  // namespace kalman
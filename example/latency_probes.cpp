@@ -0,0 +1,106 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "fast_clocks.h"
+#include "timing_probes.h"
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/si.h>
+#endif
+
+namespace {
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+probes::counter requests;
+probes::histogram latencies;
+
+// a request handler with a latency depending on the size of the request
+std::uint64_t handle_request(std::uint64_t size)
+{
+  probes::scoped_timer t1{requests};
+  probes::scoped_timer t2{latencies};
+  std::uint64_t hash = 14'695'981'039'346'656'037u;
+  for (std::uint64_t i = 0; i < size; ++i) hash = (hash ^ i) * 1'099'511'628'211u;
+  return hash;
+}
+
+// average cost of a probe with an empty scope
+template<typename Clock>
+quantity<ns, double> probe_cost()
+{
+  constexpr std::int64_t iterations = 1'000'000;
+  probes::counter c;
+  const auto start = now<std::chrono::steady_clock>();
+  for (std::int64_t i = 0; i < iterations; ++i) probes::scoped_timer<probes::counter, Clock> t{c};
+  return value_cast<double>(now<std::chrono::steady_clock>() - start) / static_cast<double>(iterations);
+}
+
+}  // namespace
+
+int main()
+{
+  constexpr std::size_t workers = 4;
+  constexpr std::uint64_t requests_per_worker = 100'000;
+
+  // every worker records its request batches into its own ring buffer
+  std::vector<std::unique_ptr<probes::ring_buffer<1024>>> batches;
+  for (std::size_t w = 0; w < workers; ++w) batches.push_back(std::make_unique<probes::ring_buffer<1024>>());
+  {
+    std::vector<std::jthread> pool;
+    for (std::size_t w = 0; w < workers; ++w)
+      pool.emplace_back([&batch_times = *batches[w]] {
+        std::uint64_t sink = 0;
+        for (std::uint64_t i = 0; i < requests_per_worker; i += 100) {
+          probes::scoped_timer t{batch_times};
+          for (std::uint64_t j = i; j < i + 100; ++j) sink += handle_request(j % 1000);
+        }
+        if (sink == 0) std::cout << sink;
+      });
+  }
+
+  std::cout << "Requests: " << requests.count() << ", total " << requests.total().in<double>(ms) << ", mean "
+            << requests.mean() << "\n";
+  std::cout << "Latency p50 <= " << latencies.quantile(0.5) << ", p99 <= " << latencies.quantile(0.99) << "\n";
+  for (std::size_t w = 0; w < workers; ++w) {
+    probes::duration slowest = probes::duration::zero();
+    const std::uint64_t dropped = batches[w]->drain([&](probes::duration d) { slowest = std::max(slowest, d); });
+    std::cout << "Worker " << w << ": slowest batch of 100 requests " << slowest.in<double>(us) << " (" << dropped
+              << " batches not kept)\n";
+  }
+
+  std::cout << "Cost of a probe with steady_clock: " << probe_cost<std::chrono::steady_clock>() << "\n";
+  std::cout << "Cost of a probe with tsc_clock: " << probe_cost<clocks::tsc_clock>() << "\n";
+}
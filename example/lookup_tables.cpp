@@ -0,0 +1,139 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "glide_computer_lib.h"
+#include "lookup_table.h"
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/format.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/international.h>
+#include <mp-units/systems/isq.h>
+#include <mp-units/systems/si.h>
+#endif
+
+namespace {
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+using namespace glide_computer;
+
+// polar of an SZD-51 Junior glider
+using polar_table = tables::lookup_table<rate_of_climb, tables::nonuniform_axis<velocity, 7>>;
+constexpr polar_table junior_polar{
+  tables::nonuniform_axis<velocity, 7>{
+    {70. * km / h, 80. * km / h, 90. * km / h, 100. * km / h, 120. * km / h, 140. * km / h, 160. * km / h}},
+  {-0.66 * m / s, -0.6349 * m / s, -0.68 * m / s, -0.76 * m / s, -1.05 * m / s, -1.47 * m / s, -2.02 * m / s}};
+
+static_assert(junior_polar(80. * km / h) == -0.6349 * m / s);
+static_assert(junior_polar(75. * km / h) == (-0.66 - 0.6349) / 2 * m / s);
+static_assert(junior_polar(200. * km / h) == -2.02 * m / s);
+
+// International Standard Atmosphere
+using altitude = quantity<isq::altitude[m]>;
+using air_density = quantity<isq::mass_density[kg / m3]>;
+using temperature_deviation = quantity<isq::thermodynamic_temperature[K]>;
+
+using isa_table = tables::lookup_table<air_density, tables::uniform_axis<altitude, 12>>;
+constexpr isa_table isa_density{
+  {0. * m, 11'000. * m},
+  {1.225 * kg / m3, 1.1116 * kg / m3, 1.0065 * kg / m3, 0.9091 * kg / m3, 0.8191 * kg / m3, 0.7361 * kg / m3,
+   0.6597 * kg / m3, 0.5895 * kg / m3, 0.5252 * kg / m3, 0.4663 * kg / m3, 0.4127 * kg / m3, 0.3639 * kg / m3}};
+
+// air density of a non-standard day
+using density_table = tables::lookup_table<air_density, tables::uniform_axis<altitude, 5>,
+                                           tables::uniform_axis<temperature_deviation, 3>>;
+constexpr density_table density{
+  {0. * m, 4'000. * m},
+  {delta<K>(-20.), delta<K>(20.)},
+  {1.3164 * kg / m3, 1.225 * kg / m3, 1.1455 * kg / m3,    // 0 m
+   1.1966 * kg / m3, 1.1116 * kg / m3, 1.0379 * kg / m3,   // 1000 m
+   1.0854 * kg / m3, 1.0065 * kg / m3, 0.9383 * kg / m3,   // 2000 m
+   0.9822 * kg / m3, 0.9091 * kg / m3, 0.8461 * kg / m3,   // 3000 m
+   0.8868 * kg / m3, 0.8191 * kg / m3, 0.7611 * kg / m3}};  // 4000 m
+
+static_assert(density(0. * m, delta<K>(0.)) == isa_density(0. * m));
+static_assert(density(2000. * m, delta<K>(0.)) == isa_density(2000. * m));
+
+void polar()
+{
+  using namespace mp_units::international::unit_symbols;
+
+  std::cout << "SZD-51 Junior polar:\n";
+  for (const auto v : {40. * kn, 45. * kn, 50. * kn, 60. * kn, 70. * kn, 80. * kn}) {
+    const rate_of_climb sink = junior_polar(v);
+    std::cout << MP_UNITS_STD_FMT::format("- {::N[.0f]} ({::N[.0f]}): {::N[.2f]}, L/D {::N[.1f]}\n", v, v.in(km / h),
+                                          sink, (v / -sink).in(one));
+  }
+
+  // the best glide ratio on a fine grid of airspeeds swept in order, so that the cursor avoids binary searches
+  polar_table::cursor sink_rate(junior_polar);
+  velocity best_v = 70. * km / h;
+  for (velocity v = 70. * km / h; v <= 160. * km / h; v += 0.5 * km / h)
+    if (v / -sink_rate(v) > best_v / -sink_rate(best_v)) best_v = v;
+  std::cout << MP_UNITS_STD_FMT::format("Best glide: {::N[.1f]} at {::N[.1f]}\n\n",
+                                        (best_v / -junior_polar(best_v)).in(one), best_v);
+}
+
+void atmosphere()
+{
+  using namespace mp_units::international::unit_symbols;
+
+  std::cout << "Air density:\n";
+  for (const auto alt : {0. * ft, 3'000. * ft, 6'500. * ft, 10'000. * ft})
+    std::cout << MP_UNITS_STD_FMT::format("- {::N[.0f]}: ISA {::N[.4f]}, ISA-15 {::N[.4f]}, ISA+15 {::N[.4f]}\n", alt,
+                                          isa_density(alt), density(alt, delta<K>(-15.)), density(alt, delta<K>(15.)));
+
+  // batch evaluation of a million altitude samples
+  std::mt19937_64 gen(42);
+  std::uniform_real_distribution<double> dist(0., 11'000.);
+  std::vector<altitude> altitudes;
+  altitudes.reserve(1'000'000);
+  for (std::size_t i = 0; i < altitudes.capacity(); ++i) altitudes.push_back(dist(gen) * m);
+  std::vector<air_density> densities(altitudes.size());
+
+  const auto start = std::chrono::steady_clock::now();
+  isa_density.evaluate(std::span<const altitude>(altitudes), std::span(densities));
+  const quantity elapsed{std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)};
+  std::cout << MP_UNITS_STD_FMT::format("Evaluated {} altitudes in {::N[.2f]} ({::N[.2f]} per sample)\n",
+                                        altitudes.size(), elapsed,
+                                        (elapsed / static_cast<double>(altitudes.size())).in(si::nano<si::second>));
+}
+
+}  // namespace
+
+int main()
+{
+  polar();
+  atmosphere();
+}
@@ -0,0 +1,165 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "flat_hash_map.h"
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/framework.h>
+#include <mp-units/systems/si.h>
+#endif
+
+using namespace mp_units;
+
+// clang-format off
+inline constexpr struct dim_currency final : base_dimension<"$"> {} dim_currency;
+
+QUANTITY_SPEC(currency, dim_currency);
+
+inline constexpr struct us_dollar final : named_unit<"USD", kind_of<currency>> {} us_dollar;
+inline constexpr struct us_cent final : named_unit<"USc", mag_ratio<1, 100> * us_dollar> {} us_cent;
+// clang-format on
+
+namespace {
+
+using price = quantity<us_cent, std::int64_t>;
+using volume = quantity<one, std::int64_t>;
+using latency = quantity<si::micro<si::second>, std::int64_t>;
+
+static_assert(std::is_trivially_copyable_v<price>);
+
+struct order_event {
+  price level;
+  volume delta;  // positive for the new orders and negative for the cancellations
+};
+
+std::vector<order_event> generate_events(std::size_t count)
+{
+  std::mt19937_64 gen(42);
+  std::normal_distribution<double> level_dist(10'000., 250.);
+  std::uniform_int_distribution<std::int64_t> lots(1, 10);
+  std::bernoulli_distribution is_new(0.55);
+
+  std::vector<order_event> events;
+  events.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const volume size = lots(gen) * 100 * one;
+    events.push_back({static_cast<std::int64_t>(level_dist(gen)) * us_cent, is_new(gen) ? size : -size});
+  }
+  return events;
+}
+
+// aggregates the events into the volumes resting at each of the price levels of the book
+template<typename Map>
+void apply(Map& book, const std::vector<order_event>& events)
+{
+  for (const order_event& e : events) {
+    if (e.delta > volume::zero()) {
+      book[e.level] += e.delta;
+      continue;
+    }
+    const auto it = book.find(e.level);
+    if (it == book.end()) continue;
+    auto& resting = [&]() -> volume& {
+      if constexpr (requires { it->second; })
+        return it->second;
+      else
+        return it->value;
+    }();
+    resting = std::max(resting + e.delta, volume::zero());
+    if (resting == volume::zero()) book.erase(e.level);
+  }
+}
+
+template<typename F>
+auto measure(F&& f)
+{
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  return quantity{std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)};
+}
+
+void order_book()
+{
+  const std::vector<order_event> events = generate_events(2'000'000);
+
+  containers::flat_hash_map<price, volume> flat;
+  std::unordered_map<price, volume> node_based;
+  const auto flat_time = measure([&] { apply(flat, events); });
+  const auto node_time = measure([&] { apply(node_based, events); });
+
+  const bool same = flat.size() == node_based.size() && std::ranges::all_of(flat, [&](const auto& level) {
+                      const auto it = node_based.find(level.key);
+                      return it != node_based.end() && it->second == level.value;
+                    });
+
+  const auto& deepest = *std::ranges::max_element(flat, {}, [](const auto& level) { return level.value; });
+  std::cout << "Order book of " << events.size() << " events with " << flat.size() << " price levels\n";
+  std::cout << "  deepest level:      " << deepest.key.in<double>(us_dollar) << " (" << deepest.value << ")\n";
+  std::cout << "  flat_hash_map:      " << flat_time << "\n";
+  std::cout << "  std::unordered_map: " << node_time << "\n";
+  std::cout << "  same contents:      " << std::boolalpha << same << "\n";
+}
+
+void latency_histogram()
+{
+  constexpr latency bin_width = 10 * si::micro<si::second>;
+
+  std::mt19937_64 gen(7);
+  std::lognormal_distribution<double> dist(4.5, 0.4);
+
+  // the bins are keyed by the lower bound of the latency range they cover
+  containers::flat_hash_map<latency, std::int64_t> bins;
+  for (int i = 0; i < 100'000; ++i) {
+    const latency sample = static_cast<std::int64_t>(dist(gen)) * si::micro<si::second>;
+    ++bins[sample / bin_width * bin_width];
+  }
+
+  std::vector<latency> bounds;
+  for (const auto& bin : bins) bounds.push_back(bin.key);
+  std::ranges::sort(bounds);
+
+  std::cout << "\nLatency histogram of " << bins.size() << " bins\n";
+  for (const latency lower : bounds)
+    if (bins[lower] >= 2'000) std::cout << "  [" << lower << ", " << lower + bin_width << "): " << bins[lower] << "\n";
+}
+
+}  // namespace
+
+int main()
+{
+  order_book();
+  latency_histogram();
+}
@@ -0,0 +1,99 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mapped_file.h"
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numbers>
+#include <span>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/serialization.h>
+#include <mp-units/systems/si.h>
+#endif
+
+namespace {
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+using temperature = quantity_point<si::kelvin, si::zeroth_kelvin, double>;
+using pressure = quantity<si::pascal, float>;
+
+void write_archive(const std::filesystem::path& path, std::size_t samples)
+{
+  std::vector<temperature> temperatures;
+  std::vector<pressure> pressures;
+  temperatures.reserve(samples);
+  pressures.reserve(samples);
+  for (std::size_t i = 0; i < samples; ++i) {
+    const double phase = 2 * std::numbers::pi * static_cast<double>(i) / static_cast<double>(samples);
+    temperatures.push_back(point<K>(288.15 + 10 * std::sin(phase)));
+    pressures.push_back(static_cast<float>(101'325. + 1'500. * std::cos(phase)) * Pa);
+  }
+
+  std::ofstream file(path, std::ios::binary);
+  write_columnar(file, columnar_column{"temperature", temperatures}, columnar_column{"pressure", pressures});
+}
+
+}  // namespace
+
+int main()
+{
+  const std::filesystem::path path = std::filesystem::temp_directory_path() / "mp-units-sensor-archive.bin";
+  write_archive(path, 1'000'000);
+
+  {
+    const mapped_file file(path);
+    const columnar_archive archive(file.bytes());
+
+    std::cout << "Archive of " << file.bytes().size() << " bytes:\n";
+    for (const columnar_column_info& column : archive.columns())
+      std::cout << "- " << column.name << " [" << column.unit << "]: " << column.size << " x " << column.rep
+                << (column.point_origin.empty() ? "" : " from ") << column.point_origin << "\n";
+
+    // the values are read directly from the mapping
+    const std::span<const temperature> temperatures = archive.column<temperature>("temperature");
+    quantity<K> sum = delta<K>(0.);
+    for (const temperature& t : temperatures) sum += t.quantity_from_zero();
+    std::cout << "Mean temperature: " << (sum / static_cast<double>(temperatures.size())) << "\n";
+
+    // the values are converted to hectopascals on access
+    const auto pressures = archive.view<quantity<hPa, float>, pressure>("pressure");
+    const auto [min, max] = std::ranges::minmax(pressures.values());
+    std::cout << "Pressure range: " << min << " - " << max << "\n";
+  }
+
+  std::filesystem::remove(path);
+}
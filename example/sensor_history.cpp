@@ -0,0 +1,98 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "compressed_time_series.h"
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <numbers>
+#include <ranges>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/si.h>
+#include <mp-units/systems/si/chrono.h>
+#endif
+
+namespace {
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+using timestamp = quantity_point<si::second, chrono_point_origin<std::chrono::system_clock>, std::int64_t>;
+using temperature = quantity_point<si::kelvin, si::zeroth_kelvin, double>;
+using temperature_mk = quantity_point<si::milli<si::kelvin>, si::zeroth_kelvin, std::int32_t>;
+
+static_assert(std::ranges::forward_range<time_series::compressed_series<timestamp, temperature>>);
+
+// a day of a sensor sampled every second with the resolution of 0.1 K
+double reading_k(std::size_t i)
+{
+  const double daily = 5. * std::sin(2 * std::numbers::pi * static_cast<double>(i) / 86'400.);
+  return std::round((293.15 + daily) * 10.) / 10.;
+}
+
+template<typename Value>
+void report(const char* name, const time_series::compressed_series<timestamp, Value>& series)
+{
+  std::cout << name << ": " << series.size() << " samples in " << series.memory_usage() << " B ("
+            << static_cast<double>(series.memory_usage()) / static_cast<double>(series.size()) << " B per sample)\n";
+}
+
+}  // namespace
+
+int main()
+{
+  constexpr std::size_t samples = 86'400;
+  constexpr std::int64_t start_s = 1'700'000'000;
+  constexpr auto clock_origin = chrono_point_origin<std::chrono::system_clock>;
+
+  time_series::compressed_series<timestamp, temperature> series;
+  time_series::compressed_series<timestamp, temperature_mk> series_mk;
+  for (std::size_t i = 0; i < samples; ++i) {
+    const timestamp t{(start_s + static_cast<std::int64_t>(i)) * s, clock_origin};
+    const temperature value = point<K>(reading_k(i));
+    series.push_back(t, value);
+    series_mk.push_back(t, value_cast<std::int32_t>(value.in(mK)));
+  }
+  series.shrink_to_fit();
+  series_mk.shrink_to_fit();
+
+  report("double [K]", series);
+  report("int32 [mK]", series_mk);
+  std::cout << "Raw timestamps and values: " << samples * (sizeof(timestamp) + sizeof(temperature)) << " B\n";
+
+  // only the blocks of the last hour are decoded
+  const timestamp from{(start_s + static_cast<std::int64_t>(samples) - 3600) * s, clock_origin};
+  const auto last_hour = std::ranges::subrange(series.lower_bound(from), series.end()) |
+                         std::views::transform([](const auto& sample) { return sample.value; });
+  const temperature max = std::ranges::max(last_hour);
+  std::cout << "Max temperature in the last hour: " << max.quantity_from(si::ice_point).in(deg_C) << "\n";
+}
@@ -0,0 +1,182 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "geographic.h"
+#include "glide_computer_lib.h"
+#include "mapped_file.h"
+#include "terrain.h"
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/format.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numbers>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/international.h>
+#include <mp-units/systems/si.h>
+#endif
+
+namespace {
+
+using namespace geographic;
+using namespace glide_computer;
+using namespace mp_units;
+
+// 3 arc-second grid covering the area of the task
+terrain_grid_info get_grid_info()
+{
+  using namespace mp_units::si::unit_symbols;
+  constexpr double spacing = 1. / 1200;
+  return {53.3 * deg, 18.3 * deg, spacing * deg, 1441, 1081};
+}
+
+// synthetic rolling hills rising to the south and the sea in the north
+std::vector<terrain_sample> make_terrain(const terrain_grid_info& info)
+{
+  const double south = info.south.numerical_value_in(si::degree);
+  const double west = info.west.numerical_value_in(si::degree);
+  const double spacing = info.spacing.numerical_value_in(si::degree);
+  std::vector<terrain_sample> samples;
+  samples.reserve(std::size_t{info.rows} * info.cols);
+  for (std::uint32_t r = 0; r < info.rows; ++r)
+    for (std::uint32_t c = 0; c < info.cols; ++c) {
+      const double lat = south + r * spacing;
+      const double lon = west + c * spacing;
+      const double hills = 25. * std::sin(lat * 40.) * std::cos(lon * 30.) + 10. * std::sin(lon * 90. + lat * 70.);
+      const double level = std::max(0., 60. + (54.4 - lat) * 80. + hills);
+      samples.emplace_back(static_cast<std::int16_t>(std::lround(level)) * isq::altitude[si::metre], mean_sea_level);
+    }
+  return samples;
+}
+
+auto get_waypoints()
+{
+  using namespace geographic::literals;
+  using namespace mp_units::international::unit_symbols;
+  static const std::array waypoints = {
+    waypoint{"EPPR", {54.24772_N, 18.6745_E}, mean_sea_level + 16. * ft},   // N54°14'51.8" E18°40'28.2"
+    waypoint{"EPGI", {53.52442_N, 18.84947_E}, mean_sea_level + 115. * ft}  // N53°31'27.9" E18°50'58.1"
+  };
+  return waypoints;
+}
+
+void print_profiles(const task& t)
+{
+  std::cout << "Terrain profiles:\n";
+  std::cout << "=================\n";
+  for (std::size_t i = 0; i < t.get_legs().size(); ++i) {
+    const task::leg& l = t.get_legs()[i];
+    const auto profile = t.get_terrain_profile(i);
+    const auto [min, max] = std::ranges::minmax(profile);
+    std::cout << MP_UNITS_STD_FMT::format("- {} -> {}: {} samples, min {::N[.0f]}, max {::N[.0f]}\n", l.begin().name,
+                                          l.end().name, profile.size(), min.quantity_from(mean_sea_level),
+                                          max.quantity_from(mean_sea_level));
+  }
+  std::cout << "\n";
+}
+
+void benchmark(terrain_cache& cache)
+{
+  // a dense batch of positions along a west-east line through the grid
+  constexpr std::size_t count = 1'000'000;
+  std::vector<position<double>> positions;
+  positions.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const double lon = 18.35 + 0.8 * static_cast<double>(i) / (count - 1);
+    positions.push_back({latitude<double>{ranged_representation<double, -90, 90>{53.9} * si::degree, equator},
+                         longitude<double>{ranged_representation<double, -180, 180>{lon} * si::degree,
+                                           prime_meridian}});
+  }
+  std::vector<msl_altitude> out(count);
+
+  const std::size_t hits = cache.hits(), misses = cache.misses();
+  const auto start = std::chrono::steady_clock::now();
+  cache.sample(std::span<const position<double>>(positions), std::span(out));
+  const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+
+  std::cout << "Batch sampling:\n";
+  std::cout << "===============\n";
+  std::cout << MP_UNITS_STD_FMT::format("- {} samples: {:.1f} ns/sample\n", count, elapsed.count() / count);
+  std::cout << MP_UNITS_STD_FMT::format("- tile cache: {} hits, {} misses, {} of {} tiles decoded\n",
+                                        cache.hits() - hits, cache.misses() - misses, cache.size(), cache.capacity());
+  std::cout << "\n";
+}
+
+void example()
+{
+  using namespace mp_units::si::unit_symbols;
+
+  const terrain_grid_info info = get_grid_info();
+  const std::filesystem::path path = std::filesystem::temp_directory_path() / "mp_units_terrain.bin";
+  {
+    std::ofstream file(path, std::ios::binary);
+    write_terrain_grid(file, info, make_terrain(info));
+  }
+
+  const mapped_file file(path);
+  const terrain_grid grid(file.bytes());
+  terrain_cache cache(grid, 8);
+  std::cout << MP_UNITS_STD_FMT::format("Terrain grid: {} x {} samples in {} x {} tiles ({} bytes)\n\n",
+                                        grid.info().rows, grid.info().cols, grid.tiles_y(), grid.tiles_x(),
+                                        file.bytes().size());
+
+  const auto waypoints = get_waypoints();
+  task t = {waypoints[0], waypoints[1], waypoints[0]};
+  t.set_terrain(cache, 100 * m);
+  print_profiles(t);
+  benchmark(cache);
+
+  const glider g = {"SZD-51 Junior", {{80 * km / h, -0.6349 * m / s}}};
+  const weather w = {1550 * m, 2.8 * m / s};
+  const safety sfty = {300 * m};
+  const aircraft_tow tow = {400 * m, 1.6 * m / s};
+  estimate(timestamp(std::chrono::system_clock::now()), g, w, t, sfty, tow);
+
+  std::filesystem::remove(path);
+}
+
+}  // namespace
+
+int main()
+{
+  try {
+    example();
+  } catch (const std::exception& ex) {
+    std::cerr << "Unhandled std exception caught: " << ex.what() << '\n';
+  } catch (...) {
+    std::cerr << "Unhandled unknown exception caught\n";
+  }
+}
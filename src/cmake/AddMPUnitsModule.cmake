@@ -93,3 +93,34 @@ function(add_mp_units_module name target_name)
 
     add_library(mp-units::${name} ALIAS ${target_name})
 endfunction()
+
+#
+# add_mp_units_precompiled_headers(Name TargetName
+#                                  DEPENDENCIES <depependency>...
+#                                  HEADERS <header_file>...)
+#
+# Creates an interface target that propagates precompiled headers of the provided public
+# library headers (e.g., `mp-units/systems/si.h`) to all of the targets linking with it.
+# Each of those targets builds its own copy of the precompiled headers.
+#
+function(add_mp_units_precompiled_headers name target_name)
+    # parse arguments
+    set(multiValues DEPENDENCIES HEADERS)
+    cmake_parse_arguments(PARSE_ARGV 2 ARG "" "" "${multiValues}")
+
+    # validate and process arguments
+    validate_unparsed(${name} ARG)
+    validate_arguments_exists(${name} ARG DEPENDENCIES HEADERS)
+
+    # define the target
+    add_library(${target_name} INTERFACE)
+    target_link_libraries(${target_name} INTERFACE ${ARG_DEPENDENCIES})
+    list(TRANSFORM ARG_HEADERS PREPEND "<")
+    list(TRANSFORM ARG_HEADERS APPEND ">")
+    target_precompile_headers(${target_name} INTERFACE ${ARG_HEADERS})
+    set_target_properties(${target_name} PROPERTIES EXPORT_NAME ${name})
+
+    install(TARGETS ${target_name} EXPORT mp-unitsTargets)
+
+    add_library(mp-units::${name} ALIAS ${target_name})
+endfunction()
@@ -198,27 +198,4 @@ template<typename To, typename From>
   return static_cast<To>(x);
 }
 
-// The exponent of `factor` in the prime factorization of `n`.
-[[nodiscard]] consteval std::intmax_t multiplicity(std::intmax_t factor, std::intmax_t n)
-{
-  std::intmax_t m = 0;
-  while (n % factor == 0) {
-    n /= factor;
-    ++m;
-  }
-  return m;
-}
-
-// Divide a number by a given base raised to some power.
-//
-// Undefined unless base > 1, pow >= 0, and (base ^ pow) evenly divides n.
-// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-[[nodiscard]] consteval std::intmax_t remove_power(std::intmax_t base, std::intmax_t pow, std::intmax_t n)
-{
-  while (pow-- > 0) {
-    n /= base;
-  }
-  return n;
-}
-
 }  // namespace mp_units::detail
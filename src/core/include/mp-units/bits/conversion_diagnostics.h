@@ -0,0 +1,406 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/requires_hosted.h>
+//
+#include <mp-units/bits/hacks.h>
+#include <mp-units/bits/module_macros.h>
+#include <mp-units/ext/type_name.h>
+#include <mp-units/framework/quantity_concepts.h>
+#include <mp-units/framework/unit.h>
+#include <mp-units/framework/unit_magnitude.h>
+
+#ifndef MP_UNITS_IN_MODULE_INTERFACE
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#endif
+#endif
+
+#ifndef MP_UNITS_CONVERSION_DIAGNOSTICS_SAMPLING_RATE
+#define MP_UNITS_CONVERSION_DIAGNOSTICS_SAMPLING_RATE 1
+#endif
+
+namespace mp_units {
+
+MP_UNITS_EXPORT_BEGIN
+
+/**
+ * @brief Upper bounds of the relative error histogram buckets
+ *
+ * The first bucket counts exact results and the last one all the errors larger than the previous bound.
+ */
+inline constexpr std::array conversion_error_bounds = {0., 1e-15, 1e-12, 1e-9, 1e-6, 1e-3};
+
+/**
+ * @brief Errors introduced by a sampled conversion site
+ *
+ * A site is either a unique combination of the source and target units and representation types passed
+ * to `detail::sudo_cast` or a division of a quantity by a quantity or a number, or of a number by a quantity,
+ * where both representation types are integral. In the latter case `from_unit` and `from_rep` describe
+ * the dividend and `to_unit` and `to_rep` the divisor (the unit is empty for a number).
+ *
+ * The results are compared to the exact value computed in `long double`. The absolute error is expressed
+ * in the numerical value of the result.
+ */
+struct conversion_error_entry {
+  bool division;
+  std::string_view from_unit;
+  std::string_view to_unit;
+  std::string_view from_rep;
+  std::string_view to_rep;
+  std::uint64_t samples;
+  std::uint64_t inexact;
+  double max_abs_error;
+  double max_rel_error;
+  std::array<std::uint64_t, conversion_error_bounds.size() + 1> histogram;
+};
+
+MP_UNITS_EXPORT_END
+
+namespace detail {
+
+template<typename T>
+struct rep_or_value : std::type_identity<T> {};
+
+template<Quantity Q>
+struct rep_or_value<Q> : std::type_identity<typename Q::rep> {};
+
+template<typename T>
+using rep_or_value_t = rep_or_value<T>::type;
+
+struct conversion_error_site {
+  bool division;
+  std::string_view from_unit;
+  std::string_view to_unit;
+  std::string_view from_rep;
+  std::string_view to_rep;
+};
+
+struct conversion_error_stats {
+  std::uint64_t samples = 0;
+  std::uint64_t inexact = 0;
+  double max_abs_error = 0;
+  double max_rel_error = 0;
+  std::array<std::uint64_t, conversion_error_bounds.size() + 1> histogram{};
+
+  void add(long double exact, long double actual)
+  {
+    const auto abs_error = static_cast<double>(std::abs(actual - exact));
+    const double rel_error = exact != 0 ? abs_error / static_cast<double>(std::abs(exact)) : abs_error;
+    ++samples;
+    if (abs_error != 0) ++inexact;
+    max_abs_error = std::max(max_abs_error, abs_error);
+    max_rel_error = std::max(max_rel_error, rel_error);
+    const auto bucket = std::ranges::lower_bound(conversion_error_bounds, rel_error);
+    ++histogram[static_cast<std::size_t>(bucket - conversion_error_bounds.begin())];
+  }
+
+  void merge(const conversion_error_stats& other)
+  {
+    samples += other.samples;
+    inexact += other.inexact;
+    max_abs_error = std::max(max_abs_error, other.max_abs_error);
+    max_rel_error = std::max(max_rel_error, other.max_rel_error);
+    for (std::size_t i = 0; i < histogram.size(); ++i) histogram[i] += other.histogram[i];
+  }
+};
+
+struct thread_conversion_samples;
+
+/**
+ * @brief Global state of the conversion diagnostics
+ *
+ * Only every `sampling_rate()`-th call of a site in a thread is sampled. The remaining calls only bump
+ * a counter owned by the thread. The samples are accumulated in a table owned by the thread and guarded by
+ * its own mutex, which is contended only while a report is being produced. The global mutex is taken to
+ * register new sites and threads and to produce a report. The statistics of finished threads are accumulated
+ * in `totals`.
+ *
+ * The report is written to `std::clog` when the program exits.
+ */
+class conversion_diagnostics {
+  std::mutex mutex_;
+  std::vector<conversion_error_site> sites_;
+  std::vector<conversion_error_stats> totals_;
+  std::vector<thread_conversion_samples*> threads_;
+  std::deque<std::string> long_symbols_;
+  std::atomic<std::uint32_t> sampling_rate_{MP_UNITS_CONVERSION_DIAGNOSTICS_SAMPLING_RATE};
+
+  // the unit symbol of a quantity or an empty string for a number; symbols too long to be rendered at compile
+  // time are rendered once and kept as long as the diagnostics
+  template<typename T>
+  [[nodiscard]] std::string_view unit_symbol_of()
+  {
+    if constexpr (!Quantity<T>)
+      return {};
+    else if constexpr (unit_symbol_fits<unit_symbol_formatting{}, char, MP_UNITS_NONCONST_TYPE(T::unit)>)
+      return unit_symbol(T::unit);
+    else {
+      std::string& text = long_symbols_.emplace_back();
+      unit_symbol_to<char>(std::back_inserter(text), T::unit);
+      return text;
+    }
+  }
+
+  conversion_diagnostics() = default;
+  ~conversion_diagnostics() { report(std::clog); }
+
+  friend struct thread_conversion_samples;
+
+public:
+  conversion_diagnostics(const conversion_diagnostics&) = delete;
+  conversion_diagnostics& operator=(const conversion_diagnostics&) = delete;
+
+  [[nodiscard]] static conversion_diagnostics& instance()
+  {
+    static conversion_diagnostics diagnostics;
+    return diagnostics;
+  }
+
+  template<bool Division, typename From, typename To>
+  [[nodiscard]] std::size_t register_site()
+  {
+    const std::lock_guard lock(mutex_);
+    sites_.push_back({Division, unit_symbol_of<From>(), unit_symbol_of<To>(), display_type_name<rep_or_value_t<From>>(),
+                      display_type_name<rep_or_value_t<To>>()});
+    totals_.emplace_back();
+    return sites_.size() - 1;
+  }
+
+  [[nodiscard]] std::uint32_t sampling_rate() const { return sampling_rate_.load(std::memory_order_relaxed); }
+  void set_sampling_rate(std::uint32_t rate) { sampling_rate_.store(std::max(rate, 1u), std::memory_order_relaxed); }
+
+  [[nodiscard]] inline std::vector<conversion_error_entry> snapshot();
+  inline void reset();
+
+  void report(std::ostream& os)
+  {
+    std::vector<conversion_error_entry> entries = snapshot();
+    if (entries.empty()) return;
+    std::ranges::sort(entries, std::ranges::greater{}, &conversion_error_entry::max_rel_error);
+    os << "mp-units conversion errors (sampling rate 1/" << sampling_rate() << "):\n";
+    for (const conversion_error_entry& e : entries) {
+      os << "  " << (e.from_unit.empty() ? e.from_rep : e.from_unit) << (e.division ? " / " : " -> ")
+         << (e.to_unit.empty() ? e.to_rep : e.to_unit)
+         << " [" << e.from_rep;
+      if (e.division || e.from_rep != e.to_rep) os << (e.division ? " / " : " -> ") << e.to_rep;
+      os << "]: " << e.samples << " samples, " << e.inexact << " inexact, max abs error " << e.max_abs_error
+         << ", max rel error " << e.max_rel_error << "\n    rel error histogram: 0: " << e.histogram[0];
+      for (std::size_t i = 1; i < conversion_error_bounds.size(); ++i)
+        os << ", <=" << conversion_error_bounds[i] << ": " << e.histogram[i];
+      os << ", >" << conversion_error_bounds.back() << ": " << e.histogram.back() << '\n';
+    }
+  }
+};
+
+/**
+ * @brief Sampled error statistics of the conversion sites executed by the current thread
+ */
+struct thread_conversion_samples {
+  std::mutex mutex;
+  std::vector<conversion_error_stats> stats;
+  std::vector<std::uint32_t> calls;  // accessed only by the owning thread
+
+  thread_conversion_samples()
+  {
+    conversion_diagnostics& d = conversion_diagnostics::instance();
+    const std::lock_guard lock(d.mutex_);
+    d.threads_.push_back(this);
+  }
+
+  ~thread_conversion_samples()
+  {
+    conversion_diagnostics& d = conversion_diagnostics::instance();
+    const std::lock_guard lock(d.mutex_);
+    const std::lock_guard own_lock(mutex);
+    for (std::size_t i = 0; i < stats.size(); ++i) d.totals_[i].merge(stats[i]);
+    std::erase(d.threads_, this);
+  }
+
+  thread_conversion_samples(const thread_conversion_samples&) = delete;
+  thread_conversion_samples& operator=(const thread_conversion_samples&) = delete;
+
+  [[nodiscard]] bool should_sample(std::size_t id)
+  {
+    if (id >= calls.size()) [[unlikely]]
+      calls.resize(id + 1);
+    if (++calls[id] < conversion_diagnostics::instance().sampling_rate()) return false;
+    calls[id] = 0;
+    return true;
+  }
+
+  void add(std::size_t id, long double exact, long double actual)
+  {
+    const std::lock_guard lock(mutex);
+    if (id >= stats.size()) [[unlikely]]
+      stats.resize(id + 1);
+    stats[id].add(exact, actual);
+  }
+
+  [[nodiscard]] static thread_conversion_samples& instance()
+  {
+    thread_local thread_conversion_samples samples;
+    return samples;
+  }
+};
+
+std::vector<conversion_error_entry> conversion_diagnostics::snapshot()
+{
+  const std::lock_guard lock(mutex_);
+  std::vector<conversion_error_stats> stats = totals_;
+  for (thread_conversion_samples* t : threads_) {
+    const std::lock_guard thread_lock(t->mutex);
+    for (std::size_t i = 0; i < t->stats.size(); ++i) stats[i].merge(t->stats[i]);
+  }
+  std::vector<conversion_error_entry> res;
+  for (std::size_t i = 0; i < sites_.size(); ++i)
+    if (stats[i].samples != 0) {
+      const conversion_error_site& s = sites_[i];
+      const conversion_error_stats& st = stats[i];
+      res.push_back({s.division, s.from_unit, s.to_unit, s.from_rep, s.to_rep, st.samples, st.inexact,
+                     st.max_abs_error, st.max_rel_error, st.histogram});
+    }
+  return res;
+}
+
+void conversion_diagnostics::reset()
+{
+  const std::lock_guard lock(mutex_);
+  std::ranges::fill(totals_, conversion_error_stats{});
+  for (thread_conversion_samples* t : threads_) {
+    const std::lock_guard thread_lock(t->mutex);
+    std::ranges::fill(t->stats, conversion_error_stats{});
+  }
+}
+
+template<typename T>
+[[nodiscard]] constexpr const rep_or_value_t<T>& numerical_value_of(const T& v)
+{
+  if constexpr (Quantity<T>)
+    return v.numerical_value_is_an_implementation_detail_;
+  else
+    return v;
+}
+
+template<bool Division, typename From, typename To>
+[[nodiscard]] std::size_t conversion_error_site_id()
+{
+  static const std::size_t id = conversion_diagnostics::instance().register_site<Division, From, To>();
+  return id;
+}
+
+/**
+ * @brief Samples the error introduced by the conversion of the numerical value `from` of `From` to `to` of `To`
+ *
+ * Only conversions between arithmetic representation types are sampled.
+ */
+template<Quantity From, Quantity To>
+void sample_conversion(const typename From::rep& from, const typename To::rep& to)
+{
+  if constexpr (std::is_arithmetic_v<typename From::rep> && std::is_arithmetic_v<typename To::rep>) {
+    const std::size_t id = conversion_error_site_id<false, From, To>();
+    thread_conversion_samples& t = thread_conversion_samples::instance();
+    if (!t.should_sample(id)) return;
+    // the rational part is applied as in `sudo_cast` to keep the reference exact for integral results
+    constexpr UnitMagnitude auto c_mag = get_canonical_unit(From::unit).mag / get_canonical_unit(To::unit).mag;
+    constexpr auto num = get_value<long double>(numerator(c_mag));
+    constexpr auto den = get_value<long double>(denominator(c_mag));
+    constexpr auto irr = get_value<long double>(c_mag * (denominator(c_mag) / numerator(c_mag)));
+    t.add(id, static_cast<long double>(from) * num / den * irr, static_cast<long double>(to));
+  }
+}
+
+/**
+ * @brief Samples the error introduced by the truncation of the integral division of `lhs` by `rhs`
+ */
+template<typename Lhs, typename Rhs>
+  requires Quantity<Lhs> || Quantity<Rhs>
+void sample_division(const Lhs& lhs, const Rhs& rhs)
+{
+  using lhs_rep = rep_or_value_t<Lhs>;
+  using rhs_rep = rep_or_value_t<Rhs>;
+  if constexpr (std::is_integral_v<lhs_rep> && std::is_integral_v<rhs_rep>) {
+    const std::size_t id = conversion_error_site_id<true, Lhs, Rhs>();
+    thread_conversion_samples& t = thread_conversion_samples::instance();
+    if (!t.should_sample(id)) return;
+    const lhs_rep a = numerical_value_of(lhs);
+    const rhs_rep b = numerical_value_of(rhs);
+    if (b == 0) return;
+    t.add(id, static_cast<long double>(a) / static_cast<long double>(b), static_cast<long double>(a / b));
+  }
+}
+
+}  // namespace detail
+
+MP_UNITS_EXPORT_BEGIN
+
+/**
+ * @brief Returns the errors of all the conversion sites sampled so far by all the threads
+ */
+[[nodiscard]] inline std::vector<conversion_error_entry> conversion_errors()
+{
+  return detail::conversion_diagnostics::instance().snapshot();
+}
+
+/**
+ * @brief Writes the sampled errors sorted by the maximum relative error to `os`
+ *
+ * The same report is written to `std::clog` at the program exit.
+ */
+inline void report_conversion_errors(std::ostream& os) { detail::conversion_diagnostics::instance().report(os); }
+
+/**
+ * @brief Clears the statistics of all the conversion sites
+ */
+inline void reset_conversion_errors() { detail::conversion_diagnostics::instance().reset(); }
+
+/**
+ * @brief Samples every `rate`-th call of every conversion site in every thread
+ *
+ * The default is provided with `MP_UNITS_CONVERSION_DIAGNOSTICS_SAMPLING_RATE` (`1` if not defined).
+ */
+inline void set_conversion_errors_sampling_rate(std::uint32_t rate)
+{
+  detail::conversion_diagnostics::instance().set_sampling_rate(rate);
+}
+
+MP_UNITS_EXPORT_END
+
+}  // namespace mp_units
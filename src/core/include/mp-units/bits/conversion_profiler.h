@@ -0,0 +1,307 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/requires_hosted.h>
+//
+#include <mp-units/bits/hacks.h>
+#include <mp-units/bits/module_macros.h>
+#include <mp-units/ext/type_name.h>
+#include <mp-units/framework/quantity_concepts.h>
+#include <mp-units/framework/quantity_point_concepts.h>
+#include <mp-units/framework/unit.h>
+
+#ifndef MP_UNITS_IN_MODULE_INTERFACE
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#endif
+#endif
+
+namespace mp_units {
+
+/**
+ * @brief Number of runtime calls of one conversion site recorded by the conversion profiler
+ *
+ * A conversion site is a unique combination of the source and target quantity types passed
+ * to `detail::sudo_cast` (e.g., by `value_cast`, `quantity::in()`, implicit conversions, or
+ * arithmetic on quantities with different units). The quantity types are described by their quantity
+ * specifications, units, and representation types.
+ */
+MP_UNITS_EXPORT struct conversion_profile_entry {
+  bool point;  ///< `true` for `quantity_point` conversions
+  std::string_view from_quantity_spec;
+  std::string_view to_quantity_spec;
+  std::string_view from_unit;
+  std::string_view to_unit;
+  std::string_view from_rep;
+  std::string_view to_rep;
+  std::uint64_t count;
+};
+
+namespace detail {
+
+struct conversion_site {
+  bool point;
+  std::string_view from_quantity_spec;
+  std::string_view to_quantity_spec;
+  std::string_view from_unit;
+  std::string_view to_unit;
+  std::string_view from_rep;
+  std::string_view to_rep;
+};
+
+struct thread_conversion_counters;
+
+/**
+ * @brief Global state of the conversion profiler
+ *
+ * Conversion sites are registered once, on their first use, and get consecutive identifiers. Every thread
+ * counts the calls in its own table indexed by those identifiers, so the hot path does not need any locking
+ * or atomic read-modify-write operations. The mutex is taken only to register new sites and threads, to grow
+ * the per-thread tables, and to produce a report. The counts of finished threads are accumulated in `totals`.
+ *
+ * The report is written to `std::clog` when the program exits.
+ */
+class conversion_profiler {
+  std::mutex mutex_;
+  std::vector<conversion_site> sites_;
+  std::vector<std::uint64_t> totals_;
+  std::vector<thread_conversion_counters*> threads_;
+  std::deque<std::string> long_symbols_;
+
+  // symbols too long to be rendered at compile time are rendered once and kept as long as the profiler
+  template<Unit U>
+  [[nodiscard]] std::string_view symbol(U u)
+  {
+    if constexpr (unit_symbol_fits<unit_symbol_formatting{}, char, U>)
+      return unit_symbol(u);
+    else {
+      std::string& text = long_symbols_.emplace_back();
+      unit_symbol_to<char>(std::back_inserter(text), u);
+      return text;
+    }
+  }
+
+  conversion_profiler() = default;
+  ~conversion_profiler() { report(std::clog); }
+
+  friend struct thread_conversion_counters;
+
+public:
+  conversion_profiler(const conversion_profiler&) = delete;
+  conversion_profiler& operator=(const conversion_profiler&) = delete;
+
+  [[nodiscard]] static conversion_profiler& instance()
+  {
+    static conversion_profiler profiler;
+    return profiler;
+  }
+
+  template<typename From, typename To>
+  [[nodiscard]] std::size_t register_site()
+  {
+    const std::lock_guard lock(mutex_);
+    sites_.push_back({QuantityPoint<From>, display_type_name<MP_UNITS_NONCONST_TYPE(From::quantity_spec)>(),
+                      display_type_name<MP_UNITS_NONCONST_TYPE(To::quantity_spec)>(), symbol(From::unit),
+                      symbol(To::unit), display_type_name<typename From::rep>(),
+                      display_type_name<typename To::rep>()});
+    totals_.push_back(0);
+    return sites_.size() - 1;
+  }
+
+  [[nodiscard]] inline std::vector<conversion_profile_entry> snapshot();
+  inline void reset();
+
+  void report(std::ostream& os)
+  {
+    std::vector<conversion_profile_entry> entries = snapshot();
+    if (entries.empty()) return;
+    std::ranges::sort(entries, std::ranges::greater{}, &conversion_profile_entry::count);
+    os << "mp-units conversion profile (calls, kind, quantity, from, to, representation):\n";
+    for (const conversion_profile_entry& e : entries) {
+      os << "  " << e.count << '\t' << (e.point ? "quantity_point" : "quantity") << '\t' << e.from_quantity_spec;
+      if (e.from_quantity_spec != e.to_quantity_spec) os << " -> " << e.to_quantity_spec;
+      os << '\t' << e.from_unit << " -> " << e.to_unit << '\t' << e.from_rep;
+      if (e.from_rep != e.to_rep) os << " -> " << e.to_rep;
+      os << '\n';
+    }
+  }
+};
+
+/**
+ * @brief Counters of the conversion sites executed by the current thread
+ *
+ * Only the owning thread writes to the counters, so relaxed loads and stores are enough for the report
+ * to read consistent values from other threads. The table grows under the profiler's mutex when
+ * a site with a new identifier is hit for the first time in this thread.
+ */
+struct thread_conversion_counters {
+  std::unique_ptr<std::atomic<std::uint64_t>[]> counters;
+  std::size_t size = 0;
+  std::size_t depth = 0;
+
+  thread_conversion_counters()
+  {
+    conversion_profiler& p = conversion_profiler::instance();
+    const std::lock_guard lock(p.mutex_);
+    p.threads_.push_back(this);
+  }
+
+  ~thread_conversion_counters()
+  {
+    conversion_profiler& p = conversion_profiler::instance();
+    const std::lock_guard lock(p.mutex_);
+    for (std::size_t i = 0; i < size; ++i) p.totals_[i] += counters[i].load(std::memory_order_relaxed);
+    std::erase(p.threads_, this);
+  }
+
+  thread_conversion_counters(const thread_conversion_counters&) = delete;
+  thread_conversion_counters& operator=(const thread_conversion_counters&) = delete;
+
+  void increment(std::size_t id)
+  {
+    if (id >= size) [[unlikely]]
+      grow(id + 1);
+    std::atomic<std::uint64_t>& c = counters[id];
+    c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  void grow(std::size_t min_size)
+  {
+    conversion_profiler& p = conversion_profiler::instance();
+    const std::lock_guard lock(p.mutex_);
+    const std::size_t new_size = std::max(min_size, p.sites_.size());
+    auto new_counters = std::make_unique<std::atomic<std::uint64_t>[]>(new_size);
+    for (std::size_t i = 0; i < size; ++i)
+      new_counters[i].store(counters[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    counters = std::move(new_counters);
+    size = new_size;
+  }
+
+  [[nodiscard]] static thread_conversion_counters& instance()
+  {
+    thread_local thread_conversion_counters counters;
+    return counters;
+  }
+};
+
+std::vector<conversion_profile_entry> conversion_profiler::snapshot()
+{
+  const std::lock_guard lock(mutex_);
+  std::vector<std::uint64_t> counts = totals_;
+  for (const thread_conversion_counters* t : threads_)
+    for (std::size_t i = 0; i < t->size; ++i) counts[i] += t->counters[i].load(std::memory_order_relaxed);
+  std::vector<conversion_profile_entry> res;
+  for (std::size_t i = 0; i < sites_.size(); ++i)
+    if (counts[i] != 0) {
+      const conversion_site& s = sites_[i];
+      res.push_back({s.point, s.from_quantity_spec, s.to_quantity_spec, s.from_unit, s.to_unit, s.from_rep, s.to_rep,
+                     counts[i]});
+    }
+  return res;
+}
+
+void conversion_profiler::reset()
+{
+  const std::lock_guard lock(mutex_);
+  std::ranges::fill(totals_, 0);
+  for (thread_conversion_counters* t : threads_)
+    for (std::size_t i = 0; i < t->size; ++i) t->counters[i].store(0, std::memory_order_relaxed);
+}
+
+template<typename From, typename To>
+[[nodiscard]] std::size_t conversion_site_id()
+{
+  static const std::size_t id = conversion_profiler::instance().register_site<From, To>();
+  return id;
+}
+
+/**
+ * @brief Records a runtime call of `sudo_cast` converting `From` to `To`
+ *
+ * Calls are recorded only for the outermost conversion of the current thread, so the nested conversions used
+ * to implement a `quantity_point` conversion are not reported separately. The site identifier is obtained
+ * only once per site.
+ */
+template<typename From, typename To>
+class conversion_scope {
+  thread_conversion_counters* counters_ = nullptr;
+public:
+  constexpr conversion_scope()
+  {
+    if (!std::is_constant_evaluated()) {
+      counters_ = &thread_conversion_counters::instance();
+      if (counters_->depth++ == 0) counters_->increment(conversion_site_id<From, To>());
+    }
+  }
+  constexpr ~conversion_scope()
+  {
+    if (counters_) --counters_->depth;
+  }
+
+  conversion_scope(const conversion_scope&) = delete;
+  conversion_scope& operator=(const conversion_scope&) = delete;
+};
+
+}  // namespace detail
+
+MP_UNITS_EXPORT_BEGIN
+
+/**
+ * @brief Returns the number of calls of every conversion site executed so far by all the threads
+ */
+[[nodiscard]] inline std::vector<conversion_profile_entry> conversion_profile()
+{
+  return detail::conversion_profiler::instance().snapshot();
+}
+
+/**
+ * @brief Writes the conversion profile sorted by the number of calls to `os`
+ *
+ * The same report is written to `std::clog` at the program exit.
+ */
+inline void report_conversion_profile(std::ostream& os) { detail::conversion_profiler::instance().report(os); }
+
+/**
+ * @brief Zeroes the counters of all the conversion sites
+ */
+inline void reset_conversion_profile() { detail::conversion_profiler::instance().reset(); }
+
+MP_UNITS_EXPORT_END
+
+}  // namespace mp_units
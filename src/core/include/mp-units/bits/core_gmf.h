@@ -55,14 +55,27 @@
 #if MP_UNITS_HOSTED
 #include <mp-units/ext/format.h>
 #ifndef MP_UNITS_IMPORT_STD
+#include <bit>
 #include <chrono>
 #include <cmath>
 #include <complex>
+#include <cstring>
+#include <istream>
 #include <locale>
 #include <ostream>
 #include <random>
+#include <span>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
+#if MP_UNITS_API_PROFILE_CONVERSIONS || MP_UNITS_API_CONVERSION_DIAGNOSTICS
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#endif
 #endif
 #endif
 
@@ -156,6 +156,14 @@ MP_UNITS_DIAGNOSTIC_POP
 
 #endif
 
+#if defined __has_builtin
+#if __has_builtin(__type_pack_element)
+
+#define MP_UNITS_HAS_TYPE_PACK_ELEMENT 1
+
+#endif
+#endif
+
 #if !defined MP_UNITS_API_NO_CRTP && __cpp_explicit_this_parameter
 
 #define MP_UNITS_API_NO_CRTP 1
@@ -174,6 +182,18 @@ MP_UNITS_DIAGNOSTIC_POP
 
 #endif
 
+#if !defined MP_UNITS_API_PROFILE_CONVERSIONS
+
+#define MP_UNITS_API_PROFILE_CONVERSIONS 0
+
+#endif
+
+#if !defined MP_UNITS_API_CONVERSION_DIAGNOSTICS
+
+#define MP_UNITS_API_CONVERSION_DIAGNOSTICS 0
+
+#endif
+
 
 #if defined(__clang__) && defined(__apple_build_version__) && __apple_build_version__ < 16000026
 #define MP_UNITS_XCODE15_HACKS
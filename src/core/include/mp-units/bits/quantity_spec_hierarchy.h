@@ -22,93 +22,89 @@
 
 #pragma once
 
+#include <mp-units/bits/hacks.h>
+#include <mp-units/bits/type_list.h>
 #include <mp-units/framework/quantity_spec_concepts.h>
 
+#ifndef MP_UNITS_IN_MODULE_INTERFACE
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <cstddef>
+#include <utility>
+#endif
+#endif
+
 namespace mp_units::detail {
 
-[[nodiscard]] consteval std::size_t hierarchy_path_length(QuantitySpec auto q)
-{
-  if constexpr (requires { q._parent_; })
-    return hierarchy_path_length(q._parent_) + 1;
-  else
-    return 1;
-}
+/**
+ * @brief Ancestors of a quantity specification
+ *
+ * A `type_list` of all the quantity specifications in the hierarchy path from the root of a hierarchy
+ * tree to `Q` (inclusive). It is instantiated only once for every quantity specification and reused by
+ * all the hierarchy queries below, which in turn do not need to walk `_parent_` chains anymore.
+ */
+template<QuantitySpec Q>
+struct hierarchy_path_impl {
+  using type = type_list<Q>;
+};
 
-template<std::size_t Offset>
-  requires(Offset >= 0)
-[[nodiscard]] consteval QuantitySpec auto hierarchy_path_advance(QuantitySpec auto q)
+template<QuantitySpec Q>
+  requires requires { Q::_parent_; }
+struct hierarchy_path_impl<Q> {
+  using type = type_list_push_back<typename hierarchy_path_impl<MP_UNITS_NONCONST_TYPE(Q::_parent_)>::type, Q>;
+};
+
+template<QuantitySpec Q>
+using hierarchy_path = hierarchy_path_impl<Q>::type;
+
+template<QuantitySpec Q>
+[[nodiscard]] consteval std::size_t hierarchy_path_length(Q)
 {
-  if constexpr (Offset == 0)
-    return q;
-  else if constexpr (requires { q._parent_; })
-    return hierarchy_path_advance<Offset - 1>(q._parent_);
+  return type_list_size<hierarchy_path<Q>>;
 }
 
-template<QuantitySpec A, QuantitySpec B>
-[[nodiscard]] consteval bool have_common_base_in_hierarchy_of_equal_length(A a, B b)
+// all the quantities of the same hierarchy tree share the root
+template<QuantitySpec Q>
+[[nodiscard]] consteval QuantitySpec auto get_hierarchy_root(Q)
 {
-  if constexpr (is_same_v<A, B>)
-    return true;
-  else if constexpr (requires { a._parent_; })
-    return have_common_base_in_hierarchy_of_equal_length(a._parent_, b._parent_);
-  else
-    return false;
+  return type_list_front<hierarchy_path<Q>>{};
 }
 
 template<QuantitySpec A, QuantitySpec B>
-[[nodiscard]] consteval bool have_common_base(A a, B b)
+[[nodiscard]] consteval bool have_common_base(A, B)
 {
-  if constexpr (is_same_v<A, B>)
-    return true;
-  else {
-    constexpr std::size_t a_length = hierarchy_path_length(A{});
-    constexpr std::size_t b_length = hierarchy_path_length(B{});
-    if constexpr (a_length > b_length)
-      return have_common_base_in_hierarchy_of_equal_length(hierarchy_path_advance<a_length - b_length>(a), b);
-    else
-      return have_common_base_in_hierarchy_of_equal_length(a, hierarchy_path_advance<b_length - a_length>(b));
-  }
+  return is_same_v<type_list_front<hierarchy_path<A>>, type_list_front<hierarchy_path<B>>>;
 }
 
-template<QuantitySpec A, QuantitySpec B>
-  requires(have_common_base_in_hierarchy_of_equal_length(A{}, B{}))
-[[nodiscard]] consteval QuantitySpec auto get_common_base_for_hierarchy_of_equal_length(A a, B b)
+// number of the leading elements that both paths share (the paths never join again once they diverge)
+template<TypeList PathA, TypeList PathB, std::size_t... Is>
+[[nodiscard]] consteval std::size_t hierarchy_path_common_length(std::index_sequence<Is...>)
 {
-  if constexpr (is_same_v<A, B>)
-    return a;
-  else
-    return get_common_base_for_hierarchy_of_equal_length(a._parent_, b._parent_);
+  return (std::size_t{0} + ... + std::size_t{is_same_v<type_list_element<PathA, Is>, type_list_element<PathB, Is>>});
 }
 
 template<QuantitySpec A, QuantitySpec B>
   requires(have_common_base(A{}, B{}))
-[[nodiscard]] consteval QuantitySpec auto get_common_base(A a, B b)
+[[nodiscard]] consteval QuantitySpec auto get_common_base(A, B)
 {
-  constexpr std::size_t a_length = hierarchy_path_length(A{});
-  constexpr std::size_t b_length = hierarchy_path_length(B{});
-  if constexpr (a_length > b_length)
-    return get_common_base_for_hierarchy_of_equal_length(hierarchy_path_advance<a_length - b_length>(a), b);
-  else
-    return get_common_base_for_hierarchy_of_equal_length(a, hierarchy_path_advance<b_length - a_length>(b));
+  using path_a = hierarchy_path<A>;
+  using path_b = hierarchy_path<B>;
+  constexpr std::size_t length = hierarchy_path_common_length<path_a, path_b>(
+    std::make_index_sequence<(type_list_size<path_a> < type_list_size<path_b> ? type_list_size<path_a>
+                                                                              : type_list_size<path_b>)>{});
+  return type_list_element<path_a, length - 1>{};
 }
 
 template<QuantitySpec Child, QuantitySpec Parent>
-[[nodiscard]] consteval bool is_child_of(Child ch, Parent p)
+[[nodiscard]] consteval bool is_child_of(Child, Parent)
 {
-  constexpr std::size_t child_length = hierarchy_path_length(Child{});
-  constexpr std::size_t parent_length = hierarchy_path_length(Parent{});
-  if constexpr (parent_length >= child_length)
+  using child_path = hierarchy_path<Child>;
+  constexpr std::size_t parent_length = type_list_size<hierarchy_path<Parent>>;
+  if constexpr (parent_length >= type_list_size<child_path>)
     return false;
   else
-    return hierarchy_path_advance<child_length - parent_length>(ch) == p;
-}
-
-[[nodiscard]] consteval QuantitySpec auto get_hierarchy_root(QuantitySpec auto q)
-{
-  if constexpr (requires { q._parent_; })
-    return get_hierarchy_root(q._parent_);
-  else
-    return q;
+    return is_same_v<type_list_element<child_path, parent_length - 1>, Parent>;
 }
 
 }  // namespace mp_units::detail
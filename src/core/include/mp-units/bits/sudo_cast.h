@@ -28,6 +28,25 @@
 #include <mp-units/framework/unit.h>
 #include <mp-units/framework/unit_magnitude.h>
 
+#if MP_UNITS_API_PROFILE_CONVERSIONS
+#include <mp-units/bits/conversion_profiler.h>
+#define MP_UNITS_PROFILE_CONVERSION(From, To) \
+  const ::mp_units::detail::conversion_scope<From, To> mp_units_conversion_scope_{}
+#else
+#define MP_UNITS_PROFILE_CONVERSION(From, To) static_assert(true)
+#endif
+
+#if MP_UNITS_API_CONVERSION_DIAGNOSTICS
+#include <mp-units/bits/conversion_diagnostics.h>
+#define MP_UNITS_SAMPLE_CONVERSION(From, To, from, to) \
+  if (!std::is_constant_evaluated()) ::mp_units::detail::sample_conversion<From, To>(from, to)
+#define MP_UNITS_SAMPLE_DIVISION(lhs, rhs) \
+  if (!std::is_constant_evaluated()) ::mp_units::detail::sample_division(lhs, rhs)
+#else
+#define MP_UNITS_SAMPLE_CONVERSION(From, To, from, to) static_assert(true)
+#define MP_UNITS_SAMPLE_DIVISION(lhs, rhs) static_assert(true)
+#endif
+
 namespace mp_units::detail {
 
 template<typename... Ts>
@@ -92,6 +111,9 @@ struct conversion_value_traits {
  * @note This is a low-level facility and is too powerful to be used by the users directly. They should either use
  * `value_cast` or `quantity_cast`.
  *
+ * @note Runtime calls are counted by the conversion profiler when `MP_UNITS_API_PROFILE_CONVERSIONS` is enabled
+ * and the errors they introduce are sampled when `MP_UNITS_API_CONVERSION_DIAGNOSTICS` is enabled.
+ *
  * @tparam To a target quantity type to cast to
  */
 template<Quantity To, typename FwdFrom, Quantity From = std::remove_cvref_t<FwdFrom>>
@@ -101,9 +123,12 @@ template<Quantity To, typename FwdFrom, Quantity From = std::remove_cvref_t<FwdF
 // TODO how to constrain the second part here?
 [[nodiscard]] constexpr To sudo_cast(FwdFrom&& q)
 {
+  MP_UNITS_PROFILE_CONVERSION(From, To);
   constexpr auto q_unit = From::unit;
   if constexpr (equivalent(q_unit, To::unit)) {
     // no scaling of the number needed
+    MP_UNITS_SAMPLE_CONVERSION(From, To, q.numerical_value_is_an_implementation_detail_,
+                               static_cast<To::rep>(q.numerical_value_is_an_implementation_detail_));
     return {static_cast<To::rep>(std::forward<FwdFrom>(q).numerical_value_is_an_implementation_detail_),
             To::reference};  // this is the only (and recommended) way to do a truncating conversion on a number, so we
                              // are using static_cast to suppress all the compiler warnings on conversions
@@ -116,6 +141,7 @@ template<Quantity To, typename FwdFrom, Quantity From = std::remove_cvref_t<FwdF
     auto scale = [&](auto func) {
       auto res =
         static_cast<To::rep>(func(static_cast<type_traits::c_type>(q.numerical_value_is_an_implementation_detail_)));
+      MP_UNITS_SAMPLE_CONVERSION(From, To, q.numerical_value_is_an_implementation_detail_, res);
       return To{res, To::reference};
     };
 
@@ -154,6 +180,7 @@ template<QuantityPoint ToQP, typename FwdFromQP, QuantityPoint FromQP = std::rem
            (!equivalent(FromQP::unit, ToQP::unit)))
 [[nodiscard]] constexpr QuantityPoint auto sudo_cast(FwdFromQP&& qp)
 {
+  MP_UNITS_PROFILE_CONVERSION(FromQP, ToQP);
   if constexpr (is_same_v<MP_UNITS_NONCONST_TYPE(ToQP::point_origin), MP_UNITS_NONCONST_TYPE(FromQP::point_origin)>) {
     return quantity_point{
       sudo_cast<typename ToQP::quantity_type>(std::forward<FwdFromQP>(qp).quantity_from(FromQP::point_origin)),
@@ -92,8 +92,29 @@ struct indexed_type_list : indexed_type_list_impl<std::index_sequence_for<Ts...>
 template<TypeList List, std::size_t I>
 using type_list_element_indexed = typename decltype(type_list_element_func<I>(std::declval<List>()))::type;
 
+#if MP_UNITS_HAS_TYPE_PACK_ELEMENT
+
+template<std::size_t I, typename... Ts>
+using type_pack_element = __type_pack_element<I, Ts...>;
+
+#else
+
+template<std::size_t I, typename... Ts>
+using type_pack_element = type_list_element_indexed<indexed_type_list<Ts...>, I>;
+
+#endif
+
+template<typename List, std::size_t I>
+struct type_list_element_impl;
+
+template<template<typename...> typename List, typename... Types, std::size_t I>
+  requires(I < sizeof...(Types))
+struct type_list_element_impl<List<Types...>, I> {
+  using type = type_pack_element<I, Types...>;
+};
+
 template<TypeList List, std::size_t I>
-using type_list_element = type_list_element_indexed<type_list_map<List, indexed_type_list>, I>;
+using type_list_element = type_list_element_impl<List, I>::type;
 
 // front
 template<typename List>
@@ -149,21 +170,27 @@ struct type_list_join_impl<List<First...>, List<Second...>, Rest...> {
 template<TypeList... Lists>
 using type_list_join = type_list_join_impl<Lists...>::type;
 
-// split
-template<typename List, typename First, typename Second>
-struct type_list_split_impl;
-
-template<template<typename...> typename List, typename... Args, std::size_t... First, std::size_t... Second>
-struct type_list_split_impl<List<Args...>, std::index_sequence<First...>, std::index_sequence<Second...>> {
-  using indexed_list = indexed_type_list<Args...>;
-  using first_list = List<type_list_element_indexed<indexed_list, First>...>;
-  using second_list = List<type_list_element_indexed<indexed_list, sizeof...(First) + Second>...>;
+// slice
+template<typename List, std::size_t Offset, typename Seq>
+struct type_list_slice_impl;
+
+template<template<typename...> typename List, typename... Args, std::size_t Offset, std::size_t... Is>
+struct type_list_slice_impl<List<Args...>, Offset, std::index_sequence<Is...>> {
+  using type = List<type_pack_element<Offset + Is, Args...>...>;
 };
 
+// elements of `List` in the range `[First, Last)`
+template<TypeList List, std::size_t First, std::size_t Last>
+  requires(First <= Last) && (Last <= type_list_size<List>)
+using type_list_slice = type_list_slice_impl<List, First, std::make_index_sequence<Last - First>>::type;
+
+// split
 template<TypeList List, std::size_t N>
   requires(N <= type_list_size<List>)
-struct type_list_split :
-    type_list_split_impl<List, std::make_index_sequence<N>, std::make_index_sequence<type_list_size<List> - N>> {};
+struct type_list_split {
+  using first_list = type_list_slice<List, 0, N>;
+  using second_list = type_list_slice<List, N, type_list_size<List>>;
+};
 
 // split_half
 template<TypeList List>
@@ -188,38 +215,121 @@ struct type_list_extract :
     type_list_extract_impl<typename type_list_split<List, N>::first_list,
                            typename type_list_split<List, N>::second_list> {};
 
+// partition_point
+// index of the first element of `List` for which `Test<Element>::value` is `false`
+// (`Test` has to be `true` for all the elements before it and `false` for all the elements after it)
+template<typename List, template<typename> typename Test, std::size_t First, std::size_t Last>
+[[nodiscard]] consteval std::size_t type_list_partition_point_impl()
+{
+  if constexpr (First == Last)
+    return First;
+  else {
+    constexpr std::size_t mid = First + (Last - First) / 2;
+    if constexpr (Test<type_list_element<List, mid>>::value)
+      return type_list_partition_point_impl<List, Test, mid + 1, Last>();
+    else
+      return type_list_partition_point_impl<List, Test, First, mid>();
+  }
+}
+
+template<TypeList List, template<typename> typename Test>
+constexpr std::size_t type_list_partition_point = type_list_partition_point_impl<List, Test, 0, type_list_size<List>>();
+
 // merge_sorted
+//
+// Short lists are merged one element at a time. Longer ones use the middle element of the longer list
+// as a pivot. Its position in the other list is found with a binary search, and the elements on both
+// sides of the pivot are merged independently. This keeps the instantiation depth logarithmic in
+// the length of the lists. Equivalent elements of `SortedList2` are placed before the ones from `SortedList1`.
+inline constexpr std::size_t type_list_merge_sorted_linear_max = 32;
+
 template<typename SortedList1, typename SortedList2, template<typename, typename> typename Pred>
-struct type_list_merge_sorted_impl;
+struct type_list_merge_sorted_linear_impl;
 
 template<template<typename...> typename List, template<typename, typename> typename Pred>
-struct type_list_merge_sorted_impl<List<>, List<>, Pred> {
+struct type_list_merge_sorted_linear_impl<List<>, List<>, Pred> {
   using type = List<>;
 };
 
 template<template<typename...> typename List, typename... Lhs, template<typename, typename> typename Pred>
-struct type_list_merge_sorted_impl<List<Lhs...>, List<>, Pred> {
+struct type_list_merge_sorted_linear_impl<List<Lhs...>, List<>, Pred> {
   using type = List<Lhs...>;
 };
 
 template<template<typename...> typename List, typename... Rhs, template<typename, typename> typename Pred>
-struct type_list_merge_sorted_impl<List<>, List<Rhs...>, Pred> {
+struct type_list_merge_sorted_linear_impl<List<>, List<Rhs...>, Pred> {
   using type = List<Rhs...>;
 };
 
 template<template<typename...> typename List, typename Lhs1, typename... LhsRest, typename Rhs1, typename... RhsRest,
          template<typename, typename> typename Pred>
   requires Pred<Lhs1, Rhs1>::value
-struct type_list_merge_sorted_impl<List<Lhs1, LhsRest...>, List<Rhs1, RhsRest...>, Pred> {
+struct type_list_merge_sorted_linear_impl<List<Lhs1, LhsRest...>, List<Rhs1, RhsRest...>, Pred> {
   using type = type_list_push_front_impl<
-    typename type_list_merge_sorted_impl<List<LhsRest...>, List<Rhs1, RhsRest...>, Pred>::type, Lhs1>::type;
+    typename type_list_merge_sorted_linear_impl<List<LhsRest...>, List<Rhs1, RhsRest...>, Pred>::type, Lhs1>::type;
 };
 
 template<template<typename...> typename List, typename Lhs1, typename... LhsRest, typename Rhs1, typename... RhsRest,
          template<typename, typename> typename Pred>
-struct type_list_merge_sorted_impl<List<Lhs1, LhsRest...>, List<Rhs1, RhsRest...>, Pred> {
+struct type_list_merge_sorted_linear_impl<List<Lhs1, LhsRest...>, List<Rhs1, RhsRest...>, Pred> {
   using type = type_list_push_front_impl<
-    typename type_list_merge_sorted_impl<List<Lhs1, LhsRest...>, List<RhsRest...>, Pred>::type, Rhs1>::type;
+    typename type_list_merge_sorted_linear_impl<List<Lhs1, LhsRest...>, List<RhsRest...>, Pred>::type, Rhs1>::type;
+};
+
+template<typename SortedList1, typename SortedList2, template<typename, typename> typename Pred>
+struct type_list_merge_sorted_impl : type_list_merge_sorted_linear_impl<SortedList1, SortedList2, Pred> {};
+
+template<typename T, template<typename, typename> typename Pred>
+struct type_list_merge_sorted_before {
+  // elements of the first list to be placed before `T` from the second one
+  template<typename U>
+  using lhs = std::bool_constant<Pred<U, T>::value>;
+
+  // elements of the second list to be placed before `T` from the first one
+  template<typename U>
+  using rhs = std::bool_constant<!Pred<T, U>::value>;
+};
+
+template<template<typename...> typename List, typename... Lhs, typename... Rhs,
+         template<typename, typename> typename Pred>
+  requires(sizeof...(Lhs) > 0) && (sizeof...(Rhs) > 0) &&
+          (sizeof...(Lhs) + sizeof...(Rhs) > type_list_merge_sorted_linear_max)
+struct type_list_merge_sorted_impl<List<Lhs...>, List<Rhs...>, Pred> {
+  using lhs = List<Lhs...>;
+  using rhs = List<Rhs...>;
+  static constexpr std::size_t lhs_size = type_list_size<lhs>;
+  static constexpr std::size_t rhs_size = type_list_size<rhs>;
+  static constexpr bool pivot_from_lhs = lhs_size >= rhs_size;
+  using pivot =
+    type_list_element<std::conditional_t<pivot_from_lhs, lhs, rhs>, (pivot_from_lhs ? lhs_size : rhs_size) / 2>;
+
+  template<bool FromLhs>
+  [[nodiscard]] static consteval std::size_t lhs_split()
+  {
+    if constexpr (FromLhs)
+      return lhs_size / 2;
+    else
+      return type_list_partition_point<lhs, type_list_merge_sorted_before<pivot, Pred>::template lhs>;
+  }
+
+  template<bool FromLhs>
+  [[nodiscard]] static consteval std::size_t rhs_split()
+  {
+    if constexpr (FromLhs)
+      return type_list_partition_point<rhs, type_list_merge_sorted_before<pivot, Pred>::template rhs>;
+    else
+      return rhs_size / 2;
+  }
+
+  static constexpr std::size_t lhs_mid = lhs_split<pivot_from_lhs>();
+  static constexpr std::size_t rhs_mid = rhs_split<pivot_from_lhs>();
+  using type = type_list_join<
+    typename type_list_merge_sorted_impl<type_list_slice<lhs, 0, lhs_mid>, type_list_slice<rhs, 0, rhs_mid>,
+                                         Pred>::type,
+    List<pivot>,
+    typename type_list_merge_sorted_impl<type_list_slice<lhs, lhs_mid + (pivot_from_lhs ? 1 : 0), lhs_size>,
+                                         type_list_slice<rhs, rhs_mid + (pivot_from_lhs ? 0 : 1), rhs_size>,
+                                         Pred>::type>;
 };
 
 template<TypeList SortedList1, TypeList SortedList2, template<typename, typename> typename Pred>
@@ -46,6 +46,7 @@ import std;
 #include <limits>
 #include <numbers>
 #include <optional>
+#include <utility>
 #endif
 #endif
 
@@ -591,26 +592,22 @@ using common_magnitude_type = decltype(common_magnitude_type_impl(M));
 // `mag()` implementation.
 
 // Helper to perform prime factorization at compile time.
+//
+// The factors are produced in increasing order, so the resulting magnitude is built directly instead of
+// multiplying the magnitudes of the consecutive prime powers.
 template<std::intmax_t N>
   requires(N > 0)
 struct prime_factorization {
-  [[nodiscard]] static consteval std::intmax_t get_or_compute_first_factor()
+  static constexpr prime_factors factors = prime_factors_v<static_cast<std::uintmax_t>(N)>;
+
+  template<std::size_t... Is>
+  [[nodiscard]] static consteval auto make_magnitude(std::index_sequence<Is...>)
   {
-    return static_cast<std::intmax_t>(find_first_factor(N));
+    return unit_magnitude<power_v_or_T<static_cast<std::intmax_t>(factors.factors[Is].prime),
+                                       ratio{static_cast<std::intmax_t>(factors.factors[Is].power)}>()...>{};
   }
 
-  static constexpr std::intmax_t first_base = get_or_compute_first_factor();
-  static constexpr std::intmax_t first_power = multiplicity(first_base, N);
-  static constexpr std::intmax_t remainder = remove_power(first_base, first_power, N);
-
-  static constexpr auto value =
-    unit_magnitude<power_v_or_T<first_base, ratio{first_power}>()>{} * prime_factorization<remainder>::value;
-};
-
-// Specialization for the prime factorization of 1 (base case).
-template<>
-struct prime_factorization<1> {
-  static constexpr unit_magnitude<> value{};
+  static constexpr auto value = make_magnitude(std::make_index_sequence<factors.size>{});
 };
 
 template<std::intmax_t N>
@@ -446,34 +446,66 @@ constexpr auto get_first_of(const Rng& rng, UnaryFunction f)
 template<std::size_t N>
 constexpr auto first_n_primes_result = first_n_primes<N>();
 
-[[nodiscard]] consteval std::uintmax_t find_first_factor(std::uintmax_t n)
+// A prime factor of a number together with its multiplicity.
+struct prime_power {
+  std::uintmax_t prime;
+  std::uintmax_t power;
+};
+
+// All the prime factors of a number in increasing order.
+struct prime_factors {
+  // The product of the first 16 primes does not fit in 64 bits.
+  std::array<prime_power, 15> factors{};
+  std::size_t size = 0;
+
+  constexpr void extract_power(std::uintmax_t prime, std::uintmax_t& n)
+  {
+    std::uintmax_t power = 0;
+    while (n % prime == 0u) {
+      n /= prime;
+      ++power;
+    }
+    factors[size++] = {prime, power};
+  }
+};
+
+// Computes the complete prime factorization of `n` in a single pass.
+//
+// The trial division continues from the last factor found, so the table of small primes is scanned at most once,
+// and the primality test is run at most once per remaining cofactor larger than the square of the largest
+// tabulated prime.
+//
+// Precondition: (n > 0).
+[[nodiscard]] consteval prime_factors factorize(std::uintmax_t n)
 {
+  MP_UNITS_EXPECTS_DEBUG(n > 0u);
+
   constexpr auto first_100_primes = first_n_primes_result<100>;
 
+  prime_factors result{};
   for (const auto& p : first_100_primes) {
-    if (n % p == 0u) {
-      return p;
-    }
     if (p * p > n) {
-      return n;
+      if (n > 1u) result.extract_power(n, n);
+      return result;
     }
+    if (n % p == 0u) result.extract_power(p, n);
   }
 
-  // If we got this far, and we haven't found a factor, and haven't terminated... maybe it's prime?  Do a fast check.
-  if (baillie_psw_probable_prime(n)) {
-    return n;
-  }
-
-  // If we're here, we know `n` is composite, so continue with trial division for all odd numbers.
   std::uintmax_t factor = first_100_primes.back() + 2u;
-  while (factor * factor <= n) {
-    if (n % factor == 0u) {
-      return factor;
+  while (n > 1u) {
+    if (factor * factor > n || baillie_psw_probable_prime(n)) {
+      result.extract_power(n, n);
+      break;
     }
-    factor += 2u;
+    while (n % factor != 0u) factor += 2u;
+    result.extract_power(factor, n);
   }
-
-  return n;  // Technically unreachable.
+  return result;
 }
 
+// Memoizes the factorization of `N`, so that it is computed only once per translation unit no matter how
+// many magnitudes refer to it.
+template<std::uintmax_t N>
+constexpr prime_factors prime_factors_v = factorize(N);
+
 }  // namespace mp_units::detail
@@ -45,6 +45,19 @@ template<typename T>
   return name;
 }
 
+/**
+ * @brief The name of `T` suitable for diagnostic messages
+ *
+ * GCC appends the definitions of the aliases used in a function signature (e.g., `; std::string_view = ...`)
+ * to the name returned by `type_name()`.
+ */
+template<typename T>
+[[nodiscard]] consteval std::string_view display_type_name()
+{
+  const std::string_view name = type_name<T>();
+  return name.substr(0, name.find(';'));
+}
+
 template<typename Lhs, typename Rhs>
 struct type_name_less : std::bool_constant<type_name<Lhs>() < type_name<Rhs>()> {};
 
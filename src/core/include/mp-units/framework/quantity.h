@@ -48,6 +48,8 @@
 import std;
 #else
 #include <compare>  // IWYU pragma: export
+#include <cstddef>
+#include <functional>
 #include <limits>
 #include <utility>
 #if MP_UNITS_HOSTED
@@ -468,6 +470,7 @@ public:
   constexpr quantity& operator/=(const Value& val) &
   {
     MP_UNITS_EXPECTS_DEBUG(val != representation_values<Value>::zero());
+    MP_UNITS_SAMPLE_DIVISION(*this, val);
     numerical_value_is_an_implementation_detail_ /= val;
     return *this;
   }
@@ -593,6 +596,7 @@ public:
   [[nodiscard]] friend constexpr Quantity auto operator/(const Q& lhs, const quantity<R2, Rep2>& rhs)
   {
     MP_UNITS_EXPECTS_DEBUG(is_neq_zero(rhs));
+    MP_UNITS_SAMPLE_DIVISION(lhs, rhs);
     return ::mp_units::quantity{lhs.numerical_value_ref_in(unit) / rhs.numerical_value_ref_in(rhs.unit), R / R2};
   }
 
@@ -602,6 +606,7 @@ public:
   [[nodiscard]] friend constexpr QuantityOf<quantity_spec> auto operator/(const Q& q, const Value& val)
   {
     MP_UNITS_EXPECTS_DEBUG(val != representation_values<Value>::zero());
+    MP_UNITS_SAMPLE_DIVISION(q, val);
     return ::mp_units::quantity{q.numerical_value_ref_in(unit) / val, R};
   }
 
@@ -611,6 +616,7 @@ public:
   [[nodiscard]] friend constexpr Quantity auto operator/(const Value& val, const Q& q)
   {
     MP_UNITS_EXPECTS_DEBUG(is_neq_zero(q));
+    MP_UNITS_SAMPLE_DIVISION(val, q);
     return ::mp_units::quantity{val / q.numerical_value_ref_in(unit), one / R};
   }
 
@@ -712,6 +718,26 @@ template<auto R, typename Rep, mp_units::RepresentationOf<mp_units::get_quantity
   requires requires { typename std::common_type<mp_units::quantity<R, Rep>, Value>; }
 struct std::common_type<Value, mp_units::quantity<R, Rep>> : std::common_type<mp_units::quantity<R, Rep>, Value> {};
 
+// hash support
+/**
+ * @brief Hashes the numerical value of a quantity expressed in its own unit
+ *
+ * The hash is consistent with `operator==` only for quantities of the same type. Equal quantities of
+ * different types (e.g. `1 * km` and `1000 * m`) do not have to produce the same hash and should be
+ * converted to a common type before being used as keys of the same container.
+ */
+template<auto R, typename Rep>
+  requires requires(const Rep& v) {
+    { std::hash<Rep>{}(v) } -> std::convertible_to<std::size_t>;
+  }
+struct std::hash<mp_units::quantity<R, Rep>> {
+  [[nodiscard]] std::size_t operator()(const mp_units::quantity<R, Rep>& q) const
+    noexcept(noexcept(std::hash<Rep>{}(q.numerical_value_ref_in(q.unit))))
+  {
+    return std::hash<Rep>{}(q.numerical_value_ref_in(q.unit));
+  }
+};
+
 template<auto R, typename Rep>
   requires std::numeric_limits<Rep>::is_specialized
 class std::numeric_limits<mp_units::quantity<R, Rep>> : public std::numeric_limits<Rep> {
@@ -36,7 +36,10 @@
 import std;
 #else
 #include <compare>  // IWYU pragma: export
+#include <cstddef>
+#include <functional>
 #include <limits>
+#include <type_traits>
 #endif
 #endif
 
@@ -577,6 +580,22 @@ quantity_point(QP)
 
 }  // namespace mp_units
 
+// hash support
+/**
+ * @brief Hashes the quantity of a point measured from its own point origin
+ *
+ * The hash is consistent with `operator==` only for points of the same type.
+ */
+template<auto R, auto PO, typename Rep>
+  requires std::is_default_constructible_v<std::hash<mp_units::quantity<R, Rep>>>
+struct std::hash<mp_units::quantity_point<R, PO, Rep>> {
+  [[nodiscard]] std::size_t operator()(const mp_units::quantity_point<R, PO, Rep>& qp) const
+    noexcept(noexcept(std::hash<mp_units::quantity<R, Rep>>{}(qp.quantity_ref_from(PO))))
+  {
+    return std::hash<mp_units::quantity<R, Rep>>{}(qp.quantity_ref_from(PO));
+  }
+};
+
 template<auto R, auto PO, typename Rep>
   requires std::numeric_limits<Rep>::is_specialized
 class std::numeric_limits<mp_units::quantity_point<R, PO, Rep>> : public std::numeric_limits<Rep> {
@@ -51,6 +51,7 @@
 import std;
 #else
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
 #include <string_view>
@@ -901,21 +902,93 @@ constexpr Out unit_symbol_to(Out out, U u, const unit_symbol_formatting& fmt = u
 
 namespace detail {
 
+inline constexpr std::size_t unit_symbol_max_length = 128;
+
+// symbol rendered at compile time; characters beyond the capacity are dropped and only reported
+template<typename CharT>
+struct unit_symbol_text {
+  detail::inplace_vector<CharT, unit_symbol_max_length> text;
+  bool overflow = false;
+};
+
+// output iterator appending to `unit_symbol_text` that records an overflow instead of failing
+template<typename CharT>
+struct unit_symbol_text_inserter {
+  using difference_type = std::ptrdiff_t;
+  unit_symbol_text<CharT>* symbol;
+
+  constexpr unit_symbol_text_inserter& operator*() { return *this; }
+  constexpr unit_symbol_text_inserter& operator=(CharT ch)
+  {
+    if (symbol->text.try_emplace_back(ch) == nullptr) symbol->overflow = true;
+    return *this;
+  }
+  constexpr unit_symbol_text_inserter& operator++() { return *this; }
+  constexpr unit_symbol_text_inserter operator++(int) { return *this; }
+};
+
+// the only compile-time rendering of a unit symbol; shared by `unit_symbol()` and `unit_symbol_fits`
+template<unit_symbol_formatting fmt, typename CharT, Unit U>
+constexpr unit_symbol_text<CharT> rendered_unit_symbol = [] {
+  // std::basic_string<CharT> text;  // TODO use when https://wg21.link/P3032 is supported
+  unit_symbol_text<CharT> symbol;
+  unit_symbol_to<CharT>(unit_symbol_text_inserter<CharT>{&symbol}, U{}, fmt);
+  return symbol;
+}();
+
+/**
+ * @brief Checks if the unit symbol can be rendered at compile time by `unit_symbol()`
+ */
+template<unit_symbol_formatting fmt, typename CharT, Unit U>
+constexpr bool unit_symbol_fits = !rendered_unit_symbol<fmt, CharT, U>.overflow;
+
 MP_UNITS_EXPORT template<unit_symbol_formatting fmt, typename CharT, Unit U>
 [[nodiscard]] consteval auto unit_symbol_impl(U)
 {
-  constexpr auto oversized_symbol_text = []() consteval {
-    // std::basic_string<CharT> text;  // TODO uncomment when https://wg21.link/P3032 is supported
-    detail::inplace_vector<CharT, 128> text;
-    unit_symbol_to<CharT>(std::back_inserter(text), U{}, fmt);
-    return text;
-  }();
-  return basic_fixed_string<CharT, oversized_symbol_text.size()>(std::from_range, oversized_symbol_text);
+  static_assert(unit_symbol_fits<fmt, CharT, U>,
+                "The unit symbol is too long to be rendered at compile time; use `unit_symbol_to()` instead");
+  constexpr const auto& text = rendered_unit_symbol<fmt, CharT, U>.text;
+  return basic_fixed_string<CharT, text.size()>(std::from_range, text);
 }
 
 template<unit_symbol_formatting fmt, typename CharT, Unit U>
 constexpr auto unit_symbol_result = unit_symbol_impl<fmt, CharT>(U{});
 
+template<typename CharT>
+concept CachedSymbolCharT = is_same_v<CharT, char> || is_same_v<CharT, char8_t>;
+
+// symbols can't be rendered at compile time for other character types
+template<typename CharT, Unit U>
+constexpr bool has_cached_unit_symbol = false;
+
+template<CachedSymbolCharT CharT, Unit U>
+constexpr bool has_cached_unit_symbol<CharT, U> = unit_symbol_fits<unit_symbol_formatting{}, CharT, U>;
+
+[[nodiscard]] constexpr bool is_default_unit_symbol_formatting(const unit_symbol_formatting& fmt)
+{
+  constexpr unit_symbol_formatting defaults{};
+  return fmt.char_set == defaults.char_set && fmt.solidus == defaults.solidus && fmt.separator == defaults.separator;
+}
+
+/**
+ * @brief Writes the unit symbol to the output iterator
+ *
+ * The symbol for the default formatting options is copied from the text rendered at compile time and shared
+ * with `unit_symbol()`. Other formatting options, character types, and symbols too long to be rendered
+ * at compile time are rendered at runtime.
+ */
+template<typename CharT, std::output_iterator<CharT> Out, Unit U>
+constexpr Out cached_unit_symbol_to(Out out, U u, const unit_symbol_formatting& fmt)
+{
+  if constexpr (has_cached_unit_symbol<CharT, U>) {
+    if (is_default_unit_symbol_formatting(fmt)) {
+      constexpr std::basic_string_view<CharT> symbol = unit_symbol_result<unit_symbol_formatting{}, CharT, U>.view();
+      return detail::copy(symbol.begin(), symbol.end(), out);
+    }
+  }
+  return unit_symbol_to<CharT>(out, u, fmt);
+}
+
 }  // namespace detail
 
 // TODO Refactor to `unit_symbol(U, fmt)` when P1045: constexpr Function Parameters is available
@@ -930,8 +1003,12 @@ MP_UNITS_EXPORT template<unit_symbol_formatting fmt = unit_symbol_formatting{},
 MP_UNITS_EXPORT template<typename CharT, typename Traits, Unit U>
 std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, U u)
 {
-  return detail::to_stream(
-    os, [&](std::basic_ostream<CharT, Traits>& oss) { unit_symbol_to<CharT>(std::ostream_iterator<CharT>(oss), u); });
+  return detail::to_stream(os, [&](std::basic_ostream<CharT, Traits>& oss) {
+    if constexpr (detail::has_cached_unit_symbol<CharT, U>)
+      oss << unit_symbol<unit_symbol_formatting{}, CharT>(u);
+    else
+      unit_symbol_to<CharT>(std::ostream_iterator<CharT>(oss), u);
+  });
 }
 
 #endif  // MP_UNITS_HOSTED
@@ -1020,9 +1097,9 @@ public:
 
     if (specs.width == 0)
       // Avoid extra copying if width is not specified
-      return mp_units::unit_symbol_to<Char>(ctx.out(), u, specs);
+      return mp_units::detail::cached_unit_symbol_to<Char>(ctx.out(), u, specs);
     std::basic_string<Char> unit_buffer;
-    mp_units::unit_symbol_to<Char>(std::back_inserter(unit_buffer), u, specs);
+    mp_units::detail::cached_unit_symbol_to<Char>(std::back_inserter(unit_buffer), u, specs);
 
     const std::basic_string<Char> global_format_buffer =
       "{:" + std::basic_string<Char>{fill_align_width_format_str_} + "}";
@@ -0,0 +1,751 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/requires_hosted.h>
+//
+#include <mp-units/bits/module_macros.h>
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/type_name.h>
+#include <mp-units/framework/quantity.h>
+#include <mp-units/framework/quantity_point.h>
+#include <mp-units/framework/unit.h>
+
+#ifndef MP_UNITS_IN_MODULE_INTERFACE
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#endif
+#endif
+
+namespace mp_units {
+
+namespace detail {
+
+inline constexpr std::uint64_t fnv1a_offset_basis = 14'695'981'039'346'656'037u;
+inline constexpr std::uint64_t fnv1a_prime = 1'099'511'628'211u;
+
+[[nodiscard]] constexpr std::uint64_t fnv1a(std::uint64_t hash, std::string_view text)
+{
+  for (const char ch : text) {
+    hash ^= static_cast<unsigned char>(ch);
+    hash *= fnv1a_prime;
+  }
+  return hash;
+}
+
+// Hashes a type name skipping the parts that differ between compilers (whitespace and class-keys)
+[[nodiscard]] constexpr std::uint64_t fnv1a_type_name(std::uint64_t hash, std::string_view name)
+{
+  constexpr auto is_identifier = [](char ch) {
+    return ch == '_' || (ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+  };
+  bool token_start = true;
+  while (!name.empty()) {
+    if (token_start && name.starts_with("struct "))
+      name.remove_prefix(7);
+    else if (token_start && name.starts_with("class "))
+      name.remove_prefix(6);
+    else {
+      const char ch = name.front();
+      name.remove_prefix(1);
+      token_start = !is_identifier(ch);
+      if (ch != ' ') hash = fnv1a(hash, std::string_view(&ch, 1));
+    }
+  }
+  return hash;
+}
+
+template<typename Rep>
+concept BinarySerializableRep =
+  (std::integral<Rep> && !std::same_as<Rep, bool>) ||
+  (std::floating_point<Rep> && std::numeric_limits<Rep>::is_iec559 && (sizeof(Rep) == 4 || sizeof(Rep) == 8));
+
+template<typename Rep>
+[[nodiscard]] consteval std::array<char, 2> rep_schema()
+{
+  constexpr char category = std::floating_point<Rep> ? 'f' : (std::is_signed_v<Rep> ? 'i' : 'u');
+  return {category, static_cast<char>('0' + sizeof(Rep))};
+}
+
+// Hashes the bytes of a value independently of the endianness of the platform
+template<typename Rep>
+  requires std::integral<Rep> || std::floating_point<Rep>
+[[nodiscard]] consteval std::uint64_t fnv1a_value(std::uint64_t hash, Rep value)
+{
+  std::uint64_t bits = 0;
+  if constexpr (std::floating_point<Rep>)
+    bits = std::bit_cast<std::uint64_t>(static_cast<double>(value));
+  else
+    bits = static_cast<std::uint64_t>(value);
+  for (int i = 0; i < 8; ++i) {
+    hash ^= (bits >> (8 * i)) & 0xFF;
+    hash *= fnv1a_prime;
+  }
+  return hash;
+}
+
+// Hashes a point origin with a spelling that does not depend on the compiler
+//
+// The names of the origins that are specializations of class templates with non-type template parameters
+// (e.g. `zeroth_point_origin_<isq::height>`) differ between compilers, so such origins are described
+// by their quantity specification or by their absolute origin and offset instead.
+template<PointOrigin PO>
+[[nodiscard]] consteval std::uint64_t fnv1a_point_origin(std::uint64_t hash)
+{
+  if constexpr (is_zeroth_point_origin(PO{})) {
+    hash = fnv1a(hash, "zeroth(");
+    hash = fnv1a_type_name(hash, display_type_name<MP_UNITS_NONCONST_TYPE(PO::_quantity_spec_)>());
+    return fnv1a(hash, ")");
+  } else if constexpr (is_derived_from_specialization_of_v<PO, relative_point_origin>) {
+    constexpr auto offset = PO::_quantity_point_.quantity_from(PO::_absolute_point_origin_);
+    constexpr auto canonical = get_canonical_unit(offset.unit);
+    hash = fnv1a(hash, "relative(");
+    hash = fnv1a_point_origin<MP_UNITS_NONCONST_TYPE(PO::_absolute_point_origin_)>(hash);
+    hash = fnv1a(hash, ";");
+    hash = fnv1a(hash, unit_symbol<unit_symbol_formatting{.char_set = character_set::portable}>(
+                         canonical.mag * canonical.reference_unit));
+    hash = fnv1a(hash, ";");
+    hash = fnv1a_value(hash, offset.numerical_value_in(offset.unit));
+    return fnv1a(hash, ")");
+  } else
+    return fnv1a_type_name(hash, display_type_name<PO>());
+}
+
+template<typename Q>
+[[nodiscard]] consteval std::uint64_t make_schema_hash()
+{
+  constexpr unit_symbol_formatting fmt{.char_set = character_set::portable};
+  constexpr auto canonical = get_canonical_unit(Q::unit);
+  constexpr std::array<char, 2> rep = rep_schema<typename Q::rep>();
+
+  std::uint64_t hash = fnv1a(fnv1a_offset_basis, "mp-units/1;");
+  hash = fnv1a_type_name(hash, display_type_name<MP_UNITS_NONCONST_TYPE(Q::quantity_spec)>());
+  hash = fnv1a(hash, ";");
+  hash = fnv1a(hash, dimension_symbol<dimension_symbol_formatting{.char_set = character_set::portable}>(
+                       Q::quantity_spec.dimension));
+  hash = fnv1a(hash, ";");
+  hash = fnv1a(hash, unit_symbol<fmt>(canonical.mag * canonical.reference_unit));
+  hash = fnv1a(hash, ";");
+  hash = fnv1a(hash, std::string_view(rep.data(), rep.size()));
+  if constexpr (QuantityPoint<Q>) {
+    hash = fnv1a(hash, ";");
+    hash = fnv1a_point_origin<MP_UNITS_NONCONST_TYPE(Q::point_origin)>(hash);
+  }
+  return hash;
+}
+
+template<typename T>
+[[nodiscard]] T load_little_endian(const std::byte* ptr)
+{
+  std::array<std::byte, sizeof(T)> bytes;
+  std::memcpy(bytes.data(), ptr, sizeof(T));
+  if constexpr (std::endian::native == std::endian::big) std::ranges::reverse(bytes);
+  return std::bit_cast<T>(bytes);
+}
+
+template<typename T>
+void store_little_endian(std::byte* ptr, T value)
+{
+  auto bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(value);
+  if constexpr (std::endian::native == std::endian::big) std::ranges::reverse(bytes);
+  std::memcpy(ptr, bytes.data(), sizeof(T));
+}
+
+}  // namespace detail
+
+MP_UNITS_EXPORT_BEGIN
+
+/**
+ * @brief A quantity or quantity point type that can be written with the binary serialization layer
+ *
+ * The representation type has to be an integral type (other than `bool`) or an IEEE 754 binary32 or binary64
+ * floating-point type as those have the same binary layout on all supported platforms. Quantity points are
+ * stored as their quantities measured from their point origins.
+ */
+template<typename Q>
+concept BinarySerializable = (Quantity<Q> || QuantityPoint<Q>) && detail::BinarySerializableRep<typename Q::rep>;
+
+/**
+ * @brief Compile-time 64-bit hash of the binary schema of a quantity or quantity point type
+ *
+ * The hash is computed from the quantity specification, its dimension, the canonical unit (the magnitude
+ * and the reference unit expressed in base units), the category and size of the representation type, and,
+ * for quantity points, the point origin. Neither the dimension nor the units depend on the compiler used.
+ * For quantity specifications and named point origins, the differences in the type names produced by the
+ * compilers (whitespace and class-keys) are skipped. Zeroth point origins are described by their quantity
+ * specifications and relative point origins by their absolute origins and offsets.
+ */
+template<BinarySerializable Q>
+inline constexpr std::uint64_t binary_schema_hash = detail::make_schema_hash<Q>();
+
+/**
+ * @brief Size of the schema header written once per message or stream
+ *
+ * The header consists of a 4-byte magic, a 4-byte format version, the 8-byte schema hash, and the 8-byte
+ * number of the values that follow. All the numbers are stored in little-endian byte order.
+ */
+inline constexpr std::size_t binary_header_size = 24;
+
+MP_UNITS_EXPORT_END
+
+namespace detail {
+
+inline constexpr std::array binary_magic = {std::byte{'M'}, std::byte{'P'}, std::byte{'U'}, std::byte{'Q'}};
+inline constexpr std::uint32_t binary_format_version = 1;
+inline constexpr std::uint64_t binary_unbounded_count = std::numeric_limits<std::uint64_t>::max();
+
+struct binary_header {
+  std::uint64_t schema_hash;
+  std::uint64_t count;
+};
+
+inline void write_binary_header(std::byte* ptr, const binary_header& header)
+{
+  std::memcpy(ptr, binary_magic.data(), binary_magic.size());
+  store_little_endian(ptr + 4, binary_format_version);
+  store_little_endian(ptr + 8, header.schema_hash);
+  store_little_endian(ptr + 16, header.count);
+}
+
+[[nodiscard]] inline binary_header read_binary_header(const std::byte* ptr)
+{
+  if (std::memcmp(ptr, binary_magic.data(), binary_magic.size()) != 0)
+    MP_UNITS_THROW(std::invalid_argument("not an mp-units binary message"));
+  if (load_little_endian<std::uint32_t>(ptr + 4) != binary_format_version)
+    MP_UNITS_THROW(std::invalid_argument("unsupported mp-units binary format version"));
+  return {load_little_endian<std::uint64_t>(ptr + 8), load_little_endian<std::uint64_t>(ptr + 16)};
+}
+
+template<BinarySerializable Q>
+[[nodiscard]] const typename Q::rep& binary_numerical_value(const Q& q)
+{
+  if constexpr (QuantityPoint<Q>)
+    return q.quantity_ref_from(Q::point_origin).numerical_value_ref_in(Q::unit);
+  else
+    return q.numerical_value_ref_in(Q::unit);
+}
+
+template<BinarySerializable From, BinarySerializable To>
+[[nodiscard]] To load_quantity(const std::byte* ptr)
+{
+  const From q = [&] {
+    const auto value = load_little_endian<typename From::rep>(ptr);
+    if constexpr (QuantityPoint<From>)
+      return From{typename From::quantity_type{value, From::reference}, From::point_origin};
+    else
+      return From{value, From::reference};
+  }();
+  if constexpr (std::same_as<From, To>)
+    return q;
+  else
+    return sudo_cast<To>(q);
+}
+
+template<BinarySerializable Q>
+struct binary_loader {
+  Q (*load)(const std::byte*);
+  std::size_t stride;
+  bool converting;
+};
+
+// reads the values of `Q` directly or converts them from one of the `Compatible` types
+template<BinarySerializable Q, BinarySerializable... Compatible>
+[[nodiscard]] binary_loader<Q> select_binary_loader(std::uint64_t schema_hash)
+{
+  if (schema_hash == binary_schema_hash<Q>) return {&load_quantity<Q, Q>, sizeof(typename Q::rep), false};
+  binary_loader<Q> res{};
+  const bool found = ((schema_hash == binary_schema_hash<Compatible> &&
+                       (res = {&load_quantity<Compatible, Q>, sizeof(typename Compatible::rep), true}, true)) ||
+                      ...);
+  if (!found) MP_UNITS_THROW(std::invalid_argument("incompatible mp-units binary schema"));
+  return res;
+}
+
+}  // namespace detail
+
+MP_UNITS_EXPORT_BEGIN
+
+/**
+ * @brief Appends a message with the schema header and the numerical values of `values` to `out`
+ */
+template<BinarySerializable Q>
+void write_binary(std::vector<std::byte>& out, std::span<const Q> values)
+{
+  using rep = Q::rep;
+  const std::size_t offset = out.size();
+  out.resize(offset + binary_header_size + values.size() * sizeof(rep));
+  std::byte* ptr = out.data() + offset;
+  detail::write_binary_header(ptr, {binary_schema_hash<Q>, values.size()});
+  ptr += binary_header_size;
+  for (const Q& q : values) {
+    detail::store_little_endian(ptr, detail::binary_numerical_value(q));
+    ptr += sizeof(rep);
+  }
+}
+
+class columnar_archive;
+
+/**
+ * @brief A view of the values of a binary message as quantities of type `Q`
+ *
+ * The view does not own the message. When the schema of the message matches `Q`, the numerical values are
+ * read in place without any decoding pass or copy of the message. Otherwise, every value is converted with
+ * the same rules as an implicit conversion from the quantity type stored in the message.
+ */
+template<BinarySerializable Q>
+class binary_quantity_view {
+public:
+  using value_type = Q;
+
+  binary_quantity_view() = default;
+
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+  /**
+   * @brief Returns `true` if the values are stored as a different quantity type and have to be converted
+   */
+  [[nodiscard]] bool converting() const noexcept { return loader_.converting; }
+
+  [[nodiscard]] Q operator[](std::size_t i) const
+  {
+    MP_UNITS_EXPECTS_DEBUG(i < size_);
+    return loader_.load(data_ + i * loader_.stride);
+  }
+
+  [[nodiscard]] auto values() const
+  {
+    return std::views::iota(std::size_t{0}, size_) |
+           std::views::transform([this](std::size_t i) { return (*this)[i]; });
+  }
+
+  template<BinarySerializable T, BinarySerializable... Compatible>
+    requires(std::convertible_to<Compatible, T> && ...)
+  friend binary_quantity_view<T> read_binary(std::span<const std::byte> message);
+  friend class columnar_archive;
+
+private:
+  const std::byte* data_ = nullptr;
+  std::size_t size_ = 0;
+  detail::binary_loader<Q> loader_{};
+
+  binary_quantity_view(const std::byte* data, std::size_t size, detail::binary_loader<Q> loader) :
+      data_(data), size_(size), loader_(loader)
+  {
+  }
+};
+
+/**
+ * @brief Validates the schema of a binary message and returns a view of its values as `Q`
+ *
+ * @tparam Q quantity type to read
+ * @tparam Compatible other quantity types accepted in the message; their values are converted to `Q`
+ *
+ * @throws std::invalid_argument if the message is truncated or its schema is neither `Q` nor one of `Compatible`
+ */
+template<BinarySerializable Q, BinarySerializable... Compatible>
+  requires(std::convertible_to<Compatible, Q> && ...)
+[[nodiscard]] binary_quantity_view<Q> read_binary(std::span<const std::byte> message)
+{
+  if (message.size() < binary_header_size) MP_UNITS_THROW(std::invalid_argument("truncated mp-units binary message"));
+  const detail::binary_header header = detail::read_binary_header(message.data());
+  const detail::binary_loader<Q> loader = detail::select_binary_loader<Q, Compatible...>(header.schema_hash);
+  if (header.count > (message.size() - binary_header_size) / loader.stride)
+    MP_UNITS_THROW(std::invalid_argument("truncated mp-units binary message"));
+  return {message.data() + binary_header_size, static_cast<std::size_t>(header.count), loader};
+}
+
+/**
+ * @brief Writes quantities of type `Q` to a binary stream
+ *
+ * The schema header is written once, on construction, with an unbounded number of values.
+ */
+template<BinarySerializable Q>
+class binary_writer {
+public:
+  explicit binary_writer(std::ostream& os) : os_(os)
+  {
+    std::array<std::byte, binary_header_size> header;
+    detail::write_binary_header(header.data(), {binary_schema_hash<Q>, detail::binary_unbounded_count});
+    write_bytes(header.data(), header.size());
+  }
+
+  void write(const Q& q)
+  {
+    std::array<std::byte, sizeof(typename Q::rep)> bytes;
+    detail::store_little_endian(bytes.data(), detail::binary_numerical_value(q));
+    write_bytes(bytes.data(), bytes.size());
+  }
+
+  void write(std::span<const Q> values)
+  {
+    for (const Q& q : values) write(q);
+  }
+
+private:
+  std::ostream& os_;
+
+  void write_bytes(const std::byte* data, std::size_t size)
+  {
+    os_.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+  }
+};
+
+/**
+ * @brief Reads quantities of type `Q` from a binary stream written by `binary_writer`
+ *
+ * The schema header is validated once, on construction, with the same rules as in `read_binary()`.
+ *
+ * @throws std::invalid_argument if the header is missing or its schema is neither `Q` nor one of `Compatible`
+ */
+template<BinarySerializable Q, BinarySerializable... Compatible>
+  requires(std::convertible_to<Compatible, Q> && ...)
+class binary_reader {
+public:
+  explicit binary_reader(std::istream& is) : is_(is)
+  {
+    std::array<std::byte, binary_header_size> header;
+    if (!read_bytes(header.data(), header.size()))
+      MP_UNITS_THROW(std::invalid_argument("truncated mp-units binary stream"));
+    loader_ = detail::select_binary_loader<Q, Compatible...>(detail::read_binary_header(header.data()).schema_hash);
+  }
+
+  [[nodiscard]] bool converting() const noexcept { return loader_.converting; }
+
+  /**
+   * @brief Returns the next value or `std::nullopt` at the end of the stream
+   */
+  [[nodiscard]] std::optional<Q> read()
+  {
+    std::array<std::byte, max_stride> bytes;
+    if (!read_bytes(bytes.data(), loader_.stride)) return std::nullopt;
+    return loader_.load(bytes.data());
+  }
+
+private:
+  static constexpr std::size_t max_stride = std::max({sizeof(typename Q::rep), sizeof(typename Compatible::rep)...});
+  std::istream& is_;
+  detail::binary_loader<Q> loader_{};
+
+  [[nodiscard]] bool read_bytes(std::byte* data, std::size_t size)
+  {
+    is_.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(size));
+    return static_cast<std::size_t>(is_.gcount()) == size;
+  }
+};
+
+MP_UNITS_EXPORT_END
+
+MP_UNITS_EXPORT_BEGIN
+
+/**
+ * @brief Alignment of the column blocks in a columnar archive
+ *
+ * Every block starts at an offset from the beginning of the archive being a multiple of this value which
+ * is enough to map the archive into memory and access any of its columns in place.
+ */
+inline constexpr std::size_t columnar_alignment = 64;
+
+/**
+ * @brief A named column of values to be written to a columnar archive
+ */
+template<BinarySerializable Q>
+struct columnar_column {
+  std::string_view name;
+  std::span<const Q> values;
+};
+
+template<std::ranges::contiguous_range R>
+columnar_column(std::string_view, R&&) -> columnar_column<std::ranges::range_value_t<R>>;
+
+MP_UNITS_EXPORT_END
+
+namespace detail {
+
+inline constexpr std::array columnar_magic = {std::byte{'M'}, std::byte{'P'}, std::byte{'U'}, std::byte{'C'}};
+inline constexpr std::uint32_t columnar_format_version = 1;
+inline constexpr std::size_t columnar_header_size = 16;
+inline constexpr std::size_t columnar_descriptor_size = 28;
+inline constexpr std::size_t columnar_text_count = 5;
+
+// Values stored in the archive can be accessed in place as objects of type `Q`
+template<typename Q>
+concept ColumnarInPlace = BinarySerializable<Q> && std::endian::native == std::endian::little &&
+                          std::is_trivially_copyable_v<Q> && std::is_trivially_default_constructible_v<Q> &&
+                          sizeof(Q) == sizeof(typename Q::rep) && alignof(Q) == alignof(typename Q::rep);
+
+[[nodiscard]] constexpr std::size_t columnar_align(std::size_t size)
+{
+  return (size + columnar_alignment - 1) / columnar_alignment * columnar_alignment;
+}
+
+// name, quantity specification, unit symbol, representation type, and point origin of a column
+template<BinarySerializable Q>
+[[nodiscard]] std::array<std::string_view, columnar_text_count> columnar_texts(std::string_view name)
+{
+  std::string_view origin;
+  if constexpr (QuantityPoint<Q>) origin = display_type_name<MP_UNITS_NONCONST_TYPE(Q::point_origin)>();
+  return {name, display_type_name<MP_UNITS_NONCONST_TYPE(Q::quantity_spec)>(), unit_symbol(Q::unit),
+          display_type_name<typename Q::rep>(), origin};
+}
+
+template<BinarySerializable Q>
+void append_columnar_descriptor(std::vector<std::byte>& out, const columnar_column<Q>& column, std::size_t offset)
+{
+  const auto texts = columnar_texts<Q>(column.name);
+  const std::size_t pos = out.size();
+  std::size_t size = columnar_descriptor_size;
+  for (const std::string_view text : texts) {
+    if (text.size() > std::numeric_limits<std::uint16_t>::max())
+      MP_UNITS_THROW(std::invalid_argument("too long description of an mp-units columnar archive column"));
+    size += 2 + text.size();
+  }
+  out.resize(pos + size);
+  std::byte* ptr = out.data() + pos;
+  store_little_endian(ptr, binary_schema_hash<Q>);
+  store_little_endian(ptr + 8, static_cast<std::uint64_t>(column.values.size()));
+  store_little_endian(ptr + 16, static_cast<std::uint64_t>(offset));
+  store_little_endian(ptr + 24, static_cast<std::uint8_t>(sizeof(typename Q::rep)));
+  store_little_endian(ptr + 25, static_cast<std::uint8_t>(QuantityPoint<Q>));
+  store_little_endian(ptr + 26, std::uint16_t{0});
+  ptr += columnar_descriptor_size;
+  for (const std::string_view text : texts) {
+    store_little_endian(ptr, static_cast<std::uint16_t>(text.size()));
+    std::memcpy(ptr + 2, text.data(), text.size());
+    ptr += 2 + text.size();
+  }
+}
+
+template<BinarySerializable Q>
+void write_columnar_block(std::ostream& os, std::span<const Q> values)
+{
+  using rep = Q::rep;
+  if constexpr (ColumnarInPlace<Q>)
+    os.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size_bytes()));
+  else {
+    std::array<std::byte, 4096> buffer;
+    constexpr std::size_t chunk = buffer.size() / sizeof(rep);
+    for (std::size_t i = 0; i < values.size(); i += chunk) {
+      const std::size_t n = std::min(chunk, values.size() - i);
+      for (std::size_t j = 0; j < n; ++j)
+        store_little_endian(buffer.data() + j * sizeof(rep), binary_numerical_value(values[i + j]));
+      os.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(n * sizeof(rep)));
+    }
+  }
+  const std::size_t size = values.size() * sizeof(rep);
+  const std::array<char, columnar_alignment> padding{};
+  os.write(padding.data(), static_cast<std::streamsize>(columnar_align(size) - size));
+}
+
+}  // namespace detail
+
+MP_UNITS_EXPORT_BEGIN
+
+/**
+ * @brief Writes the columns to `os` as a columnar archive
+ *
+ * The archive starts with a self-describing header. For every column it stores its name, the schema hash,
+ * the number of values, and human-readable descriptions of the quantity specification, the unit symbol,
+ * the representation type, and the point origin. The numerical values of every column follow the header
+ * as a contiguous little-endian block of `Rep` aligned to `columnar_alignment`.
+ *
+ * @throws std::invalid_argument if a description of a column is longer than 65535 bytes
+ */
+template<BinarySerializable... Qs>
+void write_columnar(std::ostream& os, const columnar_column<Qs>&... columns)
+{
+  std::vector<std::byte> header(detail::columnar_header_size);
+  std::memcpy(header.data(), detail::columnar_magic.data(), detail::columnar_magic.size());
+  detail::store_little_endian(header.data() + 4, detail::columnar_format_version);
+  detail::store_little_endian(header.data() + 8, static_cast<std::uint32_t>(sizeof...(Qs)));
+
+  // offsets depend on the size of the header, which has to be known first
+  const std::size_t descriptors_size = [&] {
+    std::vector<std::byte> tmp;
+    (detail::append_columnar_descriptor(tmp, columns, 0), ...);
+    return tmp.size();
+  }();
+  std::size_t offset = detail::columnar_align(header.size() + descriptors_size);
+  detail::store_little_endian(header.data() + 12, static_cast<std::uint32_t>(offset));
+  ((detail::append_columnar_descriptor(header, columns, offset),
+    offset += detail::columnar_align(columns.values.size() * sizeof(typename Qs::rep))),
+   ...);
+  header.resize(detail::columnar_align(header.size()));
+  os.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+  (detail::write_columnar_block(os, columns.values), ...);
+}
+
+/**
+ * @brief Description of a column stored in a columnar archive
+ *
+ * All the texts refer to the memory of the archive. `quantity_spec`, `rep`, and `point_origin` are
+ * informative only as their spelling depends on the compiler that wrote the archive; the compatibility
+ * of the columns is checked with `schema_hash`. `point_origin` is empty for the columns of quantities.
+ * `rep_size` is the size in bytes of a single stored value.
+ */
+struct columnar_column_info {
+  std::string_view name;
+  std::string_view quantity_spec;
+  std::string_view unit;
+  std::string_view rep;
+  std::string_view point_origin;
+  std::uint64_t schema_hash;
+  std::size_t size;
+  std::size_t rep_size;
+};
+
+/**
+ * @brief A read-only view of a columnar archive written by `write_columnar()`
+ *
+ * The archive does not own its memory, which is typically a memory-mapped file. All the columns are
+ * validated on construction so the accessors only look up the column and compare the schema hashes.
+ */
+class columnar_archive {
+public:
+  /**
+   * @throws std::invalid_argument if `data` is not a valid columnar archive or any of its columns is truncated
+   */
+  explicit columnar_archive(std::span<const std::byte> data) : data_(data)
+  {
+    const auto fail = [](const char* what) { MP_UNITS_THROW(std::invalid_argument(what)); };
+    if (data.size() < detail::columnar_header_size) fail("truncated mp-units columnar archive");
+    if (std::memcmp(data.data(), detail::columnar_magic.data(), detail::columnar_magic.size()) != 0)
+      fail("not an mp-units columnar archive");
+    if (detail::load_little_endian<std::uint32_t>(data.data() + 4) != detail::columnar_format_version)
+      fail("unsupported mp-units columnar archive version");
+    const auto count = detail::load_little_endian<std::uint32_t>(data.data() + 8);
+    const auto header_size = detail::load_little_endian<std::uint32_t>(data.data() + 12);
+    if (header_size > data.size()) fail("truncated mp-units columnar archive");
+
+    const std::byte* ptr = data.data() + detail::columnar_header_size;
+    const std::byte* const header_end = data.data() + header_size;
+    columns_.reserve(count);
+    blocks_.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+      if (header_end - ptr < static_cast<std::ptrdiff_t>(detail::columnar_descriptor_size))
+        fail("truncated mp-units columnar archive header");
+      const auto schema_hash = detail::load_little_endian<std::uint64_t>(ptr);
+      const auto size = detail::load_little_endian<std::uint64_t>(ptr + 8);
+      const auto offset = detail::load_little_endian<std::uint64_t>(ptr + 16);
+      const auto rep_size = detail::load_little_endian<std::uint8_t>(ptr + 24);
+      ptr += detail::columnar_descriptor_size;
+      std::array<std::string_view, detail::columnar_text_count> texts;
+      for (std::string_view& text : texts) {
+        if (header_end - ptr < 2) fail("truncated mp-units columnar archive header");
+        const auto length = detail::load_little_endian<std::uint16_t>(ptr);
+        if (header_end - ptr - 2 < length) fail("truncated mp-units columnar archive header");
+        text = {reinterpret_cast<const char*>(ptr + 2), length};
+        ptr += 2 + length;
+      }
+      if (offset % columnar_alignment != 0 || offset < header_size || offset > data.size() || rep_size == 0 ||
+          size > (data.size() - offset) / rep_size)
+        fail("truncated mp-units columnar archive column");
+      columns_.push_back(
+        {texts[0], texts[1], texts[2], texts[3], texts[4], schema_hash, static_cast<std::size_t>(size), rep_size});
+      blocks_.push_back(data.data() + offset);
+    }
+  }
+
+  [[nodiscard]] std::span<const std::byte> data() const noexcept { return data_; }
+  [[nodiscard]] std::span<const columnar_column_info> columns() const noexcept { return columns_; }
+
+  [[nodiscard]] bool contains(std::string_view name) const noexcept
+  {
+    return std::ranges::find(columns_, name, &columnar_column_info::name) != columns_.end();
+  }
+
+  /**
+   * @brief Returns the values of the column `name` in place, without any copies or conversions
+   *
+   * The column has to store exactly the values of `Q`. As quantities and quantity points of representation
+   * types having the same layout as their representation types are implicit-lifetime types, the block of the
+   * column is accessed directly as an array of `Q`.
+   *
+   * @throws std::invalid_argument if there is no such column, it stores values of a different type or size, or
+   *         the memory of the archive is not aligned for `Q`
+   */
+  template<detail::ColumnarInPlace Q>
+  [[nodiscard]] std::span<const Q> column(std::string_view name) const
+  {
+    const std::size_t i = index_of(name);
+    if (columns_[i].schema_hash != binary_schema_hash<Q> || columns_[i].rep_size != sizeof(typename Q::rep))
+      MP_UNITS_THROW(std::invalid_argument("incompatible mp-units binary schema"));
+    if (reinterpret_cast<std::uintptr_t>(blocks_[i]) % alignof(Q) != 0)
+      MP_UNITS_THROW(std::invalid_argument("misaligned mp-units columnar archive"));
+    return {reinterpret_cast<const Q*>(blocks_[i]), columns_[i].size};
+  }
+
+  /**
+   * @brief Returns a view of the column `name` that converts its values to `Q` on access
+   *
+   * @tparam Q quantity or quantity point type to read
+   * @tparam Compatible other types accepted in the column; their values are converted to `Q`
+   *
+   * @throws std::invalid_argument if there is no such column, it stores neither `Q` nor one of `Compatible`, or
+   *         the size of its values does not match the selected type
+   */
+  template<BinarySerializable Q, BinarySerializable... Compatible>
+    requires(std::convertible_to<Compatible, Q> && ...)
+  [[nodiscard]] binary_quantity_view<Q> view(std::string_view name) const
+  {
+    const std::size_t i = index_of(name);
+    const detail::binary_loader<Q> loader = detail::select_binary_loader<Q, Compatible...>(columns_[i].schema_hash);
+    if (columns_[i].rep_size != loader.stride)
+      MP_UNITS_THROW(std::invalid_argument("incompatible mp-units binary schema"));
+    return {blocks_[i], columns_[i].size, loader};
+  }
+
+private:
+  std::span<const std::byte> data_;
+  std::vector<columnar_column_info> columns_;
+  std::vector<const std::byte*> blocks_;
+
+  [[nodiscard]] std::size_t index_of(std::string_view name) const
+  {
+    const auto it = std::ranges::find(columns_, name, &columnar_column_info::name);
+    if (it == columns_.end()) MP_UNITS_THROW(std::invalid_argument("no such column in the mp-units columnar archive"));
+    return static_cast<std::size_t>(it - columns_.begin());
+  }
+};
+
+MP_UNITS_EXPORT_END
+
+}  // namespace mp_units
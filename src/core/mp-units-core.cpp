@@ -33,3 +33,6 @@ import std;
 #define MP_UNITS_IN_MODULE_INTERFACE
 
 #include <mp-units/core.h>
+#if MP_UNITS_HOSTED
+#include <mp-units/serialization.h>
+#endif
@@ -148,6 +148,20 @@ template<QuantityPointOf<MP_UNITS_IS_VALUE_WORKAROUND(isq::time)> QP>
   return ret_type(to_chrono_duration(qp - qp.absolute_point_origin));
 }
 
+/**
+ * @brief Reads `Clock` and returns the result as a quantity point
+ *
+ * The point is measured from `chrono_point_origin<Clock>` so the time points of different clocks
+ * cannot be mixed. Any type satisfying the requirements of a clock can be used, including the clocks
+ * with a cheaper `now()` than the ones provided by the standard library.
+ */
+template<typename Clock>
+  requires std::chrono::is_clock_v<Clock>
+[[nodiscard]] auto now() noexcept(noexcept(Clock::now()))
+{
+  return quantity_point(Clock::now());
+}
+
 MP_UNITS_EXPORT_END
 
 }  // namespace mp_units
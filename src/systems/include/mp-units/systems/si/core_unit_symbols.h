@@ -0,0 +1,119 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/module_macros.h>
+#include <mp-units/systems/si/core_units.h>
+#include <mp-units/systems/si/prefixes.h>
+
+// Symbols of the units provided by `<mp-units/systems/si/core_units.h>` and of their most common prefixed
+// versions. The complete set of symbols is provided by `<mp-units/systems/si/unit_symbols.h>`.
+
+MP_UNITS_EXPORT
+namespace mp_units {
+
+namespace si::unit_symbols {
+
+inline constexpr auto nm = nano<metre>;
+inline constexpr auto um = micro<metre>;
+inline constexpr auto µm = micro<metre>;
+inline constexpr auto mm = milli<metre>;
+inline constexpr auto cm = centi<metre>;
+inline constexpr auto m = metre;
+inline constexpr auto km = kilo<metre>;
+
+inline constexpr auto ns = nano<second>;
+inline constexpr auto us = micro<second>;
+inline constexpr auto µs = micro<second>;
+inline constexpr auto ms = milli<second>;
+inline constexpr auto s = second;
+
+inline constexpr auto g = gram;
+inline constexpr auto kg = kilogram;
+
+inline constexpr auto mA = milli<ampere>;
+inline constexpr auto A = ampere;
+
+inline constexpr auto K = kelvin;
+
+inline constexpr auto mol = mole;
+
+inline constexpr auto cd = candela;
+
+inline constexpr auto rad = radian;
+
+inline constexpr auto Hz = hertz;
+inline constexpr auto kHz = kilo<hertz>;
+inline constexpr auto MHz = mega<hertz>;
+
+inline constexpr auto N = newton;
+inline constexpr auto kN = kilo<newton>;
+
+#ifdef pascal
+#pragma push_macro("pascal")
+#undef pascal
+#define MP_UNITS_REDEFINE_PASCAL
+#endif
+inline constexpr auto Pa = pascal;
+inline constexpr auto kPa = kilo<pascal>;
+inline constexpr auto MPa = mega<pascal>;
+#ifdef MP_UNITS_REDEFINE_PASCAL
+#pragma pop_macro("pascal")
+#undef MP_UNITS_REDEFINE_PASCAL
+#endif
+
+inline constexpr auto J = joule;
+inline constexpr auto kJ = kilo<joule>;
+
+inline constexpr auto W = watt;
+inline constexpr auto kW = kilo<watt>;
+
+inline constexpr auto C = coulomb;
+
+inline constexpr auto mV = milli<volt>;
+inline constexpr auto V = volt;
+inline constexpr auto kV = kilo<volt>;
+
+// commonly used squared and cubic units
+inline constexpr auto m2 = square(metre);
+inline constexpr auto m3 = cubic(metre);
+inline constexpr auto s2 = square(second);
+
+}  // namespace si::unit_symbols
+
+namespace non_si::unit_symbols {
+
+// no prefixes should be provided for the below units
+inline constexpr auto min = minute;
+inline constexpr auto h = hour;
+inline constexpr auto d = day;
+
+}  // namespace non_si::unit_symbols
+
+namespace si::unit_symbols {
+
+using namespace non_si::unit_symbols;  // NOLINT(google-build-using-namespace)
+
+}  // namespace si::unit_symbols
+
+}  // namespace mp_units
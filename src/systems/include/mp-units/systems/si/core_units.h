@@ -0,0 +1,100 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/module_macros.h>
+#include <mp-units/systems/isq/si_quantities.h>
+#include <mp-units/systems/si/prefixes.h>
+
+#ifndef MP_UNITS_IN_MODULE_INTERFACE
+#include <mp-units/framework/construction_helpers.h>
+#include <mp-units/framework/quantity_point.h>
+#include <mp-units/framework/unit.h>
+#endif
+
+// The SI base units and the most commonly used derived units.
+//
+// This header can be included directly by translation units that do not need the complete system of units.
+// The remaining units are provided by `<mp-units/systems/si/units.h>`.
+
+MP_UNITS_EXPORT
+namespace mp_units {
+
+namespace si {
+
+// clang-format off
+// base units
+inline constexpr struct second final : named_unit<"s", kind_of<isq::time>> {} second;
+inline constexpr struct metre final : named_unit<"m", kind_of<isq::length>> {} metre;
+inline constexpr struct gram final : named_unit<"g", kind_of<isq::mass>> {} gram;
+inline constexpr auto kilogram = kilo<gram>;
+inline constexpr struct ampere final : named_unit<"A", kind_of<isq::electric_current>> {} ampere;
+
+inline constexpr struct absolute_zero final : absolute_point_origin<isq::thermodynamic_temperature> {} absolute_zero;
+inline constexpr auto zeroth_kelvin  = absolute_zero;
+inline constexpr struct kelvin final : named_unit<"K", kind_of<isq::thermodynamic_temperature>, zeroth_kelvin> {} kelvin;
+
+inline constexpr struct mole final : named_unit<"mol", kind_of<isq::amount_of_substance>> {} mole;
+inline constexpr struct candela final : named_unit<"cd", kind_of<isq::luminous_intensity>> {} candela;
+
+// derived named units
+inline constexpr struct radian final : named_unit<"rad", metre / metre, kind_of<isq::angular_measure>> {} radian;
+inline constexpr struct hertz final : named_unit<"Hz", one / second, kind_of<isq::frequency>> {} hertz;
+inline constexpr struct newton final : named_unit<"N", kilogram * metre / square(second)> {} newton;
+#ifdef pascal
+#pragma push_macro("pascal")
+#undef pascal
+#define MP_UNITS_REDEFINE_PASCAL
+#endif
+inline constexpr struct pascal final : named_unit<"Pa", newton / square(metre)> {} pascal;
+#ifdef MP_UNITS_REDEFINE_PASCAL
+#pragma pop_macro("pascal")
+#undef MP_UNITS_REDEFINE_PASCAL
+#endif
+inline constexpr struct joule final : named_unit<"J", newton * metre> {} joule;
+inline constexpr struct watt final : named_unit<"W", joule / second> {} watt;
+inline constexpr struct coulomb final : named_unit<"C", ampere * second> {} coulomb;
+inline constexpr struct volt final : named_unit<"V", watt / ampere> {} volt;
+// clang-format on
+
+}  // namespace si
+
+namespace non_si {
+
+// clang-format off
+// non-SI units accepted for use with the SI
+inline constexpr struct minute final : named_unit<"min", mag<60> * si::second> {} minute;
+inline constexpr struct hour final : named_unit<"h", mag<60> * minute> {} hour;
+inline constexpr struct day final : named_unit<"d", mag<24> * hour> {} day;
+// clang-format on
+
+}  // namespace non_si
+
+namespace si {
+
+// Non-SI units are accepted for use with SI
+using namespace non_si;
+
+}  // namespace si
+
+}  // namespace mp_units
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <mp-units/bits/module_macros.h>
+#include <mp-units/systems/si/core_unit_symbols.h>
 #include <mp-units/systems/si/prefixes.h>
 #include <mp-units/systems/si/units.h>
 
@@ -31,6 +32,8 @@ namespace mp_units {
 
 namespace si::unit_symbols {
 
+// the symbols of the most commonly used units are provided by `core_unit_symbols.h`
+
 inline constexpr auto qm = quecto<metre>;
 inline constexpr auto rm = ronto<metre>;
 inline constexpr auto ym = yocto<metre>;
@@ -38,16 +41,9 @@ inline constexpr auto zm = zepto<metre>;
 inline constexpr auto am = atto<metre>;
 inline constexpr auto fm = femto<metre>;
 inline constexpr auto pm = pico<metre>;
-inline constexpr auto nm = nano<metre>;
-inline constexpr auto um = micro<metre>;
-inline constexpr auto µm = micro<metre>;
-inline constexpr auto mm = milli<metre>;
-inline constexpr auto cm = centi<metre>;
 inline constexpr auto dm = deci<metre>;
-inline constexpr auto m = metre;
 inline constexpr auto dam = deca<metre>;
 inline constexpr auto hm = hecto<metre>;
-inline constexpr auto km = kilo<metre>;
 inline constexpr auto Mm = mega<metre>;
 inline constexpr auto Gm = giga<metre>;
 inline constexpr auto Tm = tera<metre>;
@@ -65,13 +61,8 @@ inline constexpr auto zs = zepto<second>;
 inline constexpr auto as = atto<second>;
 inline constexpr auto fs = femto<second>;
 inline constexpr auto ps = pico<second>;
-inline constexpr auto ns = nano<second>;
-inline constexpr auto us = micro<second>;
-inline constexpr auto µs = micro<second>;
-inline constexpr auto ms = milli<second>;
 inline constexpr auto cs = centi<second>;
 inline constexpr auto ds = deci<second>;
-inline constexpr auto s = second;
 // TODO Should the below multiples of second be provided?
 inline constexpr auto das = deca<second>;
 inline constexpr auto hs = hecto<second>;
@@ -99,10 +90,8 @@ inline constexpr auto µg = micro<gram>;
 inline constexpr auto mg = milli<gram>;
 inline constexpr auto cg = centi<gram>;
 inline constexpr auto dg = deci<gram>;
-inline constexpr auto g = gram;
 inline constexpr auto dag = deca<gram>;
 inline constexpr auto hg = hecto<gram>;
-inline constexpr auto kg = kilogram;
 inline constexpr auto Mg = mega<gram>;
 inline constexpr auto Gg = giga<gram>;
 inline constexpr auto Tg = tera<gram>;
@@ -123,10 +112,8 @@ inline constexpr auto pA = pico<ampere>;
 inline constexpr auto nA = nano<ampere>;
 inline constexpr auto uA = micro<ampere>;
 inline constexpr auto µA = micro<ampere>;
-inline constexpr auto mA = milli<ampere>;
 inline constexpr auto cA = centi<ampere>;
 inline constexpr auto dA = deci<ampere>;
-inline constexpr auto A = ampere;
 inline constexpr auto daA = deca<ampere>;
 inline constexpr auto hA = hecto<ampere>;
 inline constexpr auto kA = kilo<ampere>;
@@ -153,7 +140,6 @@ inline constexpr auto µK = micro<kelvin>;
 inline constexpr auto mK = milli<kelvin>;
 inline constexpr auto cK = centi<kelvin>;
 inline constexpr auto dK = deci<kelvin>;
-inline constexpr auto K = kelvin;
 inline constexpr auto daK = deca<kelvin>;
 inline constexpr auto hK = hecto<kelvin>;
 inline constexpr auto kK = kilo<kelvin>;
@@ -180,7 +166,6 @@ inline constexpr auto µmol = micro<mole>;
 inline constexpr auto mmol = milli<mole>;
 inline constexpr auto cmol = centi<mole>;
 inline constexpr auto dmol = deci<mole>;
-inline constexpr auto mol = mole;
 inline constexpr auto damol = deca<mole>;
 inline constexpr auto hmol = hecto<mole>;
 inline constexpr auto kmol = kilo<mole>;
@@ -207,7 +192,6 @@ inline constexpr auto µcd = micro<candela>;
 inline constexpr auto mcd = milli<candela>;
 inline constexpr auto ccd = centi<candela>;
 inline constexpr auto dcd = deci<candela>;
-inline constexpr auto cd = candela;
 inline constexpr auto dacd = deca<candela>;
 inline constexpr auto hcd = hecto<candela>;
 inline constexpr auto kcd = kilo<candela>;
@@ -234,7 +218,6 @@ inline constexpr auto µrad = micro<radian>;
 inline constexpr auto mrad = milli<radian>;
 inline constexpr auto crad = centi<radian>;
 inline constexpr auto drad = deci<radian>;
-inline constexpr auto rad = radian;
 inline constexpr auto darad = deca<radian>;
 inline constexpr auto hrad = hecto<radian>;
 inline constexpr auto krad = kilo<radian>;
@@ -288,11 +271,8 @@ inline constexpr auto µHz = micro<hertz>;
 inline constexpr auto mHz = milli<hertz>;
 inline constexpr auto cHz = centi<hertz>;
 inline constexpr auto dHz = deci<hertz>;
-inline constexpr auto Hz = hertz;
 inline constexpr auto daHz = deca<hertz>;
 inline constexpr auto hHz = hecto<hertz>;
-inline constexpr auto kHz = kilo<hertz>;
-inline constexpr auto MHz = mega<hertz>;
 inline constexpr auto GHz = giga<hertz>;
 inline constexpr auto THz = tera<hertz>;
 inline constexpr auto PHz = peta<hertz>;
@@ -315,10 +295,8 @@ inline constexpr auto µN = micro<newton>;
 inline constexpr auto mN = milli<newton>;
 inline constexpr auto cN = centi<newton>;
 inline constexpr auto dN = deci<newton>;
-inline constexpr auto N = newton;
 inline constexpr auto daN = deca<newton>;
 inline constexpr auto hN = hecto<newton>;
-inline constexpr auto kN = kilo<newton>;
 inline constexpr auto MN = mega<newton>;
 inline constexpr auto GN = giga<newton>;
 inline constexpr auto TN = tera<newton>;
@@ -347,11 +325,8 @@ inline constexpr auto µPa = micro<pascal>;
 inline constexpr auto mPa = milli<pascal>;
 inline constexpr auto cPa = centi<pascal>;
 inline constexpr auto dPa = deci<pascal>;
-inline constexpr auto Pa = pascal;
 inline constexpr auto daPa = deca<pascal>;
 inline constexpr auto hPa = hecto<pascal>;
-inline constexpr auto kPa = kilo<pascal>;
-inline constexpr auto MPa = mega<pascal>;
 inline constexpr auto GPa = giga<pascal>;
 inline constexpr auto TPa = tera<pascal>;
 inline constexpr auto PPa = peta<pascal>;
@@ -378,10 +353,8 @@ inline constexpr auto µJ = micro<joule>;
 inline constexpr auto mJ = milli<joule>;
 inline constexpr auto cJ = centi<joule>;
 inline constexpr auto dJ = deci<joule>;
-inline constexpr auto J = joule;
 inline constexpr auto daJ = deca<joule>;
 inline constexpr auto hJ = hecto<joule>;
-inline constexpr auto kJ = kilo<joule>;
 inline constexpr auto MJ = mega<joule>;
 inline constexpr auto GJ = giga<joule>;
 inline constexpr auto TJ = tera<joule>;
@@ -405,10 +378,8 @@ inline constexpr auto µW = micro<watt>;
 inline constexpr auto mW = milli<watt>;
 inline constexpr auto cW = centi<watt>;
 inline constexpr auto dW = deci<watt>;
-inline constexpr auto W = watt;
 inline constexpr auto daW = deca<watt>;
 inline constexpr auto hW = hecto<watt>;
-inline constexpr auto kW = kilo<watt>;
 inline constexpr auto MW = mega<watt>;
 inline constexpr auto GW = giga<watt>;
 inline constexpr auto TW = tera<watt>;
@@ -432,7 +403,6 @@ inline constexpr auto µC = micro<coulomb>;
 inline constexpr auto mC = milli<coulomb>;
 inline constexpr auto cC = centi<coulomb>;
 inline constexpr auto dC = deci<coulomb>;
-inline constexpr auto C = coulomb;
 inline constexpr auto daC = deca<coulomb>;
 inline constexpr auto hC = hecto<coulomb>;
 inline constexpr auto kC = kilo<coulomb>;
@@ -456,13 +426,10 @@ inline constexpr auto pV = pico<volt>;
 inline constexpr auto nV = nano<volt>;
 inline constexpr auto uV = micro<volt>;
 inline constexpr auto µV = micro<volt>;
-inline constexpr auto mV = milli<volt>;
 inline constexpr auto cV = centi<volt>;
 inline constexpr auto dV = deci<volt>;
-inline constexpr auto V = volt;
 inline constexpr auto daV = deca<volt>;
 inline constexpr auto hV = hecto<volt>;
-inline constexpr auto kV = kilo<volt>;
 inline constexpr auto MV = mega<volt>;
 inline constexpr auto GV = giga<volt>;
 inline constexpr auto TV = tera<volt>;
@@ -826,10 +793,7 @@ inline constexpr auto Qkat = quetta<katal>;
 inline constexpr auto deg_C = degree_Celsius;
 
 // commonly used squared and cubic units
-inline constexpr auto m2 = square(metre);
-inline constexpr auto m3 = cubic(metre);
 inline constexpr auto m4 = pow<4>(metre);
-inline constexpr auto s2 = square(second);
 inline constexpr auto s3 = cubic(second);
 
 }  // namespace si::unit_symbols
@@ -849,11 +813,6 @@ inline constexpr auto t = tonne;
 inline constexpr auto Da = dalton;
 inline constexpr auto eV = electronvolt;
 
-// no prefixes should be provided for the below units
-inline constexpr auto min = minute;
-inline constexpr auto h = hour;
-inline constexpr auto d = day;
-
 }  // namespace non_si::unit_symbols
 
 namespace si::unit_symbols {
@@ -24,6 +24,7 @@
 
 #include <mp-units/bits/module_macros.h>
 #include <mp-units/systems/isq/si_quantities.h>
+#include <mp-units/systems/si/core_units.h>
 #include <mp-units/systems/si/prefixes.h>
 
 #ifndef MP_UNITS_IN_MODULE_INTERFACE
@@ -38,39 +39,8 @@ namespace mp_units {
 namespace si {
 
 // clang-format off
-// base units
-inline constexpr struct second final : named_unit<"s", kind_of<isq::time>> {} second;
-inline constexpr struct metre final : named_unit<"m", kind_of<isq::length>> {} metre;
-inline constexpr struct gram final : named_unit<"g", kind_of<isq::mass>> {} gram;
-inline constexpr auto kilogram = kilo<gram>;
-inline constexpr struct ampere final : named_unit<"A", kind_of<isq::electric_current>> {} ampere;
-
-inline constexpr struct absolute_zero final : absolute_point_origin<isq::thermodynamic_temperature> {} absolute_zero;
-inline constexpr auto zeroth_kelvin  = absolute_zero;
-inline constexpr struct kelvin final : named_unit<"K", kind_of<isq::thermodynamic_temperature>, zeroth_kelvin> {} kelvin;
-
-inline constexpr struct mole final : named_unit<"mol", kind_of<isq::amount_of_substance>> {} mole;
-inline constexpr struct candela final : named_unit<"cd", kind_of<isq::luminous_intensity>> {} candela;
-
 // derived named units
-inline constexpr struct radian final : named_unit<"rad", metre / metre, kind_of<isq::angular_measure>> {} radian;
 inline constexpr struct steradian final : named_unit<"sr", square(metre) / square(metre), kind_of<isq::solid_angular_measure>> {} steradian;
-inline constexpr struct hertz final : named_unit<"Hz", one / second, kind_of<isq::frequency>> {} hertz;
-inline constexpr struct newton final : named_unit<"N", kilogram * metre / square(second)> {} newton;
-#ifdef pascal
-#pragma push_macro("pascal")
-#undef pascal
-#define MP_UNITS_REDEFINE_PASCAL
-#endif
-inline constexpr struct pascal final : named_unit<"Pa", newton / square(metre)> {} pascal;
-#ifdef MP_UNITS_REDEFINE_PASCAL
-#pragma pop_macro("pascal")
-#undef MP_UNITS_REDEFINE_PASCAL
-#endif
-inline constexpr struct joule final : named_unit<"J", newton * metre> {} joule;
-inline constexpr struct watt final : named_unit<"W", joule / second> {} watt;
-inline constexpr struct coulomb final : named_unit<"C", ampere * second> {} coulomb;
-inline constexpr struct volt final : named_unit<"V", watt / ampere> {} volt;
 inline constexpr struct farad final : named_unit<"F", coulomb / volt> {} farad;
 inline constexpr struct ohm final : named_unit<symbol_text{u8"Ω", "ohm"}, volt / ampere> {} ohm;
 inline constexpr struct siemens final : named_unit<"S", one / ohm> {} siemens;
@@ -96,9 +66,6 @@ namespace non_si {
 
 // clang-format off
 // non-SI units accepted for use with the SI
-inline constexpr struct minute final : named_unit<"min", mag<60> * si::second> {} minute;
-inline constexpr struct hour final : named_unit<"h", mag<60> * minute> {} hour;
-inline constexpr struct day final : named_unit<"d", mag<24> * hour> {} day;
 inline constexpr struct astronomical_unit final : named_unit<"au", mag<149'597'870'700> * si::metre> {} astronomical_unit;
 inline constexpr struct degree final : named_unit<symbol_text{u8"°", "deg"}, mag<π> / mag<180> * si::radian> {} degree;
 inline constexpr struct arcminute final : named_unit<symbol_text{u8"′", "'"}, mag_ratio<1, 60> * degree> {} arcminute;
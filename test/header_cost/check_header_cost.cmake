@@ -0,0 +1,74 @@
+# The MIT License (MIT)
+#
+# Copyright (c) 2018 Mateusz Pusz
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Compares the costs of including headers against their budgets.
+#
+# Usage: cmake -D REPORT_DIR=<dir> -D BUDGETS=<header=size_kib,...> -P check_header_cost.cmake
+#
+# Only the size of the part of the preprocessed translation unit coming from the mp-units headers is checked
+# against the budget. The total preprocessed size and the compilation time depend on the toolchain and the load
+# of the machine, so they are only reported.
+
+cmake_minimum_required(VERSION 3.25)
+
+string(REPLACE "," ";" BUDGETS "${BUDGETS}")
+
+set(failed FALSE)
+message("| Header | mp-units part [KiB] | Budget [KiB] | Preprocessed size [KiB] | Compilation time [s] |")
+message("|--------|--------------------:|-------------:|------------------------:|---------------------:|")
+foreach(budget IN LISTS BUDGETS)
+    string(REPLACE "=" ";" budget "${budget}")
+    list(GET budget 0 header)
+    list(GET budget 1 max_size_kib)
+
+    string(MAKE_C_IDENTIFIER "${header}" name)
+    if(NOT EXISTS "${REPORT_DIR}/${name}.txt")
+        message(FATAL_ERROR "No measurements found for `${header}`")
+    endif()
+    file(READ "${REPORT_DIR}/${name}.txt" report)
+    list(GET report 0 size)
+    list(GET report 1 mp_units_size)
+    list(GET report 2 time_ms)
+
+    math(EXPR size_kib "${size} / 1024")
+    math(EXPR mp_units_size_kib "${mp_units_size} / 1024")
+    math(EXPR time_s_int "${time_ms} / 1000")
+    math(EXPR time_s_frac "${time_ms} % 1000")
+    string(LENGTH "${time_s_frac}" len)
+    while(len LESS 3)
+        string(PREPEND time_s_frac "0")
+        string(LENGTH "${time_s_frac}" len)
+    endwhile()
+
+    set(status "")
+    if(mp_units_size_kib GREATER max_size_kib)
+        set(status " ❌")
+        set(failed TRUE)
+    endif()
+    message(
+        "| `${header}`${status} | ${mp_units_size_kib} | ${max_size_kib} | ${size_kib} | ${time_s_int}.${time_s_frac} |"
+    )
+endforeach()
+
+if(failed)
+    message(FATAL_ERROR "Some of the headers exceed their budgets")
+endif()
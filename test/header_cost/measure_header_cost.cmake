@@ -0,0 +1,107 @@
+# The MIT License (MIT)
+#
+# Copyright (c) 2018 Mateusz Pusz
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Compiler launcher measuring the cost of including a header.
+#
+# Usage: cmake -D REPORT_DIR=<dir> -P measure_header_cost.cmake -- <compiler command line>
+#
+# Compiles the translation unit with the original command line measuring the time of the compilation. Then
+# preprocesses it and stores the size of the result, the size of its part coming from the mp-units headers, and
+# the measured time in `<REPORT_DIR>/<translation unit name>.txt`.
+#
+# The part coming from the mp-units headers is found with the line markers of the preprocessor, so it does not
+# depend on the version of the standard library and catches even small increases in the size of the library.
+
+cmake_minimum_required(VERSION 3.25)
+
+set(command)
+set(found_separator FALSE)
+math(EXPR last "${CMAKE_ARGC} - 1")
+foreach(i RANGE ${last})
+    if(found_separator)
+        list(APPEND command "${CMAKE_ARGV${i}}")
+    elseif(CMAKE_ARGV${i} STREQUAL "--")
+        set(found_separator TRUE)
+    endif()
+endforeach()
+if(NOT command)
+    message(FATAL_ERROR "No compiler command line provided")
+endif()
+
+string(TIMESTAMP start "%s%f")
+execute_process(COMMAND ${command} RESULT_VARIABLE result)
+string(TIMESTAMP stop "%s%f")
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Compilation failed")
+endif()
+math(EXPR time_ms "(${stop} - ${start}) / 1000")
+
+# replace `-c` and `-o <object>` with `-E`
+set(preprocess_command)
+set(source)
+set(skip_next FALSE)
+foreach(arg IN LISTS command)
+    if(skip_next)
+        set(skip_next FALSE)
+    elseif(arg STREQUAL "-o")
+        set(skip_next TRUE)
+    elseif(NOT arg STREQUAL "-c")
+        list(APPEND preprocess_command "${arg}")
+        if(arg MATCHES "\\.cpp$")
+            set(source "${arg}")
+        endif()
+    endif()
+endforeach()
+list(APPEND preprocess_command -E)
+
+execute_process(COMMAND ${preprocess_command} OUTPUT_VARIABLE preprocessed RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Preprocessing failed")
+endif()
+string(LENGTH "${preprocessed}" size)
+
+# split the output into chunks starting with directives and count the chunks belonging to the files marked by
+# the last line marker (`# <line> "<file>"` or `#line <line> "<file>"`) as an mp-units header; characters that
+# have a special meaning in CMake lists are replaced with ones of the same length first
+string(REPLACE ";" "," preprocessed "${preprocessed}")
+string(REPLACE "[" "(" preprocessed "${preprocessed}")
+string(REPLACE "]" ")" preprocessed "${preprocessed}")
+string(REPLACE "\\" "/" preprocessed "${preprocessed}")
+string(REPLACE "\n#" ";#" chunks "${preprocessed}")
+set(mp_units_size 0)
+set(in_mp_units FALSE)
+foreach(chunk IN LISTS chunks)
+    if(chunk MATCHES "^#(line)? [0-9]+ \"([^\"]*)\"")
+        if(CMAKE_MATCH_2 MATCHES "/+include/+mp-units/+")
+            set(in_mp_units TRUE)
+        else()
+            set(in_mp_units FALSE)
+        endif()
+    endif()
+    if(in_mp_units)
+        string(LENGTH "${chunk}" chunk_size)
+        math(EXPR mp_units_size "${mp_units_size} + ${chunk_size} + 1")
+    endif()
+endforeach()
+
+get_filename_component(name "${source}" NAME_WE)
+file(WRITE "${REPORT_DIR}/${name}.txt" "${size};${mp_units_size};${time_ms}")
@@ -0,0 +1,76 @@
+# The MIT License (MIT)
+#
+# Copyright (c) 2018 Mateusz Pusz
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Compares metabench datasets with their baselines.
+#
+# usage: check_regression.rb baseline_dir dataset.json=threshold...
+#
+# The compilation time of every `n` is taken as the difference between the medians of the `total`
+# and `base` measurements (the same way as metabench charts present it). A dataset regresses if any
+# of its points exceeds the baseline by more than `threshold` (relative) plus a small absolute slack
+# that filters out the noise of very short compilations.
+
+require 'json'
+
+ABSOLUTE_SLACK = 0.05 # seconds
+
+def median(values)
+  sorted = values.sort
+  mid = sorted.length / 2
+  sorted.length.odd? ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2.0
+end
+
+def compilation_times(path)
+  JSON.parse(File.read(path))['values'].to_h do |v|
+    total = median(v['total'].map { |m| m['COMPILATION_TIME'] })
+    base = median(v['base'].map { |m| m['COMPILATION_TIME'] })
+    [v['n'], total - base]
+  end
+end
+
+baseline_dir = ARGV.shift
+failed = false
+
+ARGV.each do |arg|
+  dataset, threshold = arg.split('=')
+  threshold = Float(threshold)
+  name = File.basename(dataset, '.json')
+  baseline = File.join(baseline_dir, File.basename(dataset))
+  unless File.exist?(baseline)
+    puts "#{name}: no baseline found in '#{baseline_dir}' - skipped"
+    next
+  end
+
+  current = compilation_times(dataset)
+  reference = compilation_times(baseline)
+  reference.each do |n, ref|
+    next unless current.key?(n)
+    cur = current[n]
+    limit = ref * (1 + threshold) + ABSOLUTE_SLACK
+    status = cur > limit ? 'REGRESSION' : 'ok'
+    failed ||= cur > limit
+    puts format('%<name>s (n = %<n>s): %<cur>.3fs vs %<ref>.3fs baseline (limit %<limit>.3fs) - %<status>s',
+                name: name, n: n, cur: cur, ref: ref, limit: limit, status: status)
+  end
+end
+
+exit(failed ? 1 : 0)
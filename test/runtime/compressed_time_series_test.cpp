@@ -0,0 +1,294 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "compressed_time_series.h"
+#include <catch2/catch_test_macros.hpp>
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/isq.h>
+#include <mp-units/systems/si.h>
+#endif
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+namespace {
+
+inline constexpr struct epoch final : absolute_point_origin<isq::time> {
+} epoch;
+
+using timestamp = quantity_point<si::milli<si::second>, epoch, std::int64_t>;
+
+template<typename Rep>
+struct raw_sample {
+  std::int64_t time;
+  Rep value;
+};
+
+// compares the floating-point values bit by bit, so that -0.0 and NaNs are checked as well
+template<typename Rep>
+[[nodiscard]] bool same_bits(Rep lhs, Rep rhs)
+{
+  if constexpr (std::floating_point<Rep>) {
+    using bits = std::conditional_t<sizeof(Rep) == 4, std::uint32_t, std::uint64_t>;
+    return std::bit_cast<bits>(lhs) == std::bit_cast<bits>(rhs);
+  } else
+    return lhs == rhs;
+}
+
+template<typename Value>
+[[nodiscard]] typename Value::rep raw_value(const Value& v)
+{
+  if constexpr (QuantityPoint<Value>)
+    return v.quantity_from(Value::point_origin).numerical_value_in(Value::unit);
+  else
+    return v.numerical_value_in(Value::unit);
+}
+
+template<typename Value>
+[[nodiscard]] Value make_value(typename Value::rep v)
+{
+  if constexpr (QuantityPoint<Value>)
+    return Value{typename Value::quantity_type{v, Value::reference}, Value::point_origin};
+  else
+    return Value{v, Value::reference};
+}
+
+template<typename Value>
+[[nodiscard]] time_series::compressed_series<timestamp, Value> make_series(
+  const std::vector<raw_sample<typename Value::rep>>& samples, std::size_t block_size)
+{
+  time_series::compressed_series<timestamp, Value> series(block_size);
+  for (const auto& s : samples) series.push_back(timestamp{s.time * ms, epoch}, make_value<Value>(s.value));
+  return series;
+}
+
+template<typename Value>
+[[nodiscard]] bool round_trips(const std::vector<raw_sample<typename Value::rep>>& samples, std::size_t block_size)
+{
+  const auto series = make_series<Value>(samples, block_size);
+  if (series.size() != samples.size()) return false;
+  std::size_t i = 0;
+  for (const auto& s : series) {
+    if (i == samples.size() || s.time.quantity_from(epoch).numerical_value_in(ms) != samples[i].time ||
+        !same_bits(raw_value(s.value), samples[i].value))
+      return false;
+    ++i;
+  }
+  return i == samples.size();
+}
+
+// timestamps exercising every length of the delta-of-delta code, including repeated and far away ones
+[[nodiscard]] std::vector<std::int64_t> irregular_times(std::size_t count)
+{
+  constexpr std::int64_t steps[] = {1000, 1000, 1000, 1001, 999,    1000,    0,         0,       1000,  1050,
+                                    900,  1200, 7000, 1000, 50'000, 1000,    4'000'000, 1,       1000,  1000,
+                                    3,    1000, 250,  1000, 1000,   100'000, 1000,      1 << 20, 1000, 1000};
+  std::vector<std::int64_t> times;
+  std::int64_t t = -1'700'000'000'000;
+  for (std::size_t i = 0; i < count; ++i) {
+    times.push_back(t);
+    t += steps[i % std::size(steps)];
+  }
+  return times;
+}
+
+}  // namespace
+
+TEST_CASE("compressed series round trips the samples", "[compressed_time_series]")
+{
+  const auto times = irregular_times(200);
+
+  SECTION("regular timestamps and a slowly changing signal")
+  {
+    std::vector<raw_sample<double>> samples;
+    for (std::int64_t i = 0; i < 1000; ++i) samples.push_back({i * 1000, 20. + static_cast<double>(i / 10) * 0.25});
+    CHECK(round_trips<quantity<isq::length[m]>>(samples, 4096));
+  }
+
+  SECTION("irregular timestamps")
+  {
+    std::vector<raw_sample<double>> samples;
+    for (std::size_t i = 0; i < times.size(); ++i) samples.push_back({times[i], static_cast<double>(i) * 0.5});
+    CHECK(round_trips<quantity<isq::length[m]>>(samples, 4096));
+  }
+
+  SECTION("the largest time jumps in both directions of the delta-of-delta")
+  {
+    constexpr std::int64_t max = std::numeric_limits<std::int64_t>::max();
+    constexpr std::int64_t min = std::numeric_limits<std::int64_t>::min();
+    const std::vector<raw_sample<double>> samples = {{min, 1.}, {min, 2.}, {0, 3.}, {max, 4.}, {max, 5.}};
+    CHECK(round_trips<quantity<isq::length[m]>>(samples, 4096));
+  }
+
+  SECTION("double values changing sign")
+  {
+    std::vector<raw_sample<double>> samples;
+    for (std::size_t i = 0; i < times.size(); ++i)
+      samples.push_back({times[i], 1e3 * std::sin(0.1 * static_cast<double>(i))});
+    samples[10].value = 0.;
+    samples[11].value = -0.;
+    samples[12].value = -std::numeric_limits<double>::denorm_min();
+    samples[13].value = std::numeric_limits<double>::max();
+    samples[14].value = -std::numeric_limits<double>::infinity();
+    samples[15].value = std::numeric_limits<double>::quiet_NaN();
+    samples[16].value = -std::numeric_limits<double>::lowest();
+    CHECK(round_trips<quantity<isq::length[m]>>(samples, 4096));
+  }
+
+  SECTION("float values changing sign")
+  {
+    std::vector<raw_sample<float>> samples;
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      const double scale = i % 7 == 0 ? 1e-30 : 1e6;
+      samples.push_back({times[i], static_cast<float>(scale * std::cos(0.3 * static_cast<double>(i)))});
+    }
+    samples[20].value = -0.f;
+    samples[21].value = std::numeric_limits<float>::denorm_min();
+    samples[22].value = std::numeric_limits<float>::lowest();
+    CHECK(round_trips<quantity<isq::length[m], float>>(samples, 4096));
+  }
+
+  SECTION("integral values changing sign, including the wrap-around of the deltas")
+  {
+    constexpr std::int32_t max = std::numeric_limits<std::int32_t>::max();
+    constexpr std::int32_t min = std::numeric_limits<std::int32_t>::min();
+    std::vector<raw_sample<std::int32_t>> samples;
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      const auto v = static_cast<std::int32_t>(i);
+      samples.push_back({times[i], i % 2 == 0 ? v * 37 : -v * 1001});
+    }
+    samples[30].value = max;
+    samples[31].value = min;
+    samples[32].value = max;
+    samples[33].value = 0;
+    samples[34].value = min;
+    CHECK(round_trips<quantity_point<si::milli<si::kelvin>, si::zeroth_kelvin, std::int32_t>>(samples, 4096));
+  }
+
+  SECTION("64-bit integral values")
+  {
+    const std::vector<raw_sample<std::int64_t>> samples = {{0, 0},
+                                                           {1, std::numeric_limits<std::int64_t>::max()},
+                                                           {2, std::numeric_limits<std::int64_t>::min()},
+                                                           {3, -1},
+                                                           {4, 1}};
+    CHECK(round_trips<quantity<isq::length[m], std::int64_t>>(samples, 4096));
+  }
+
+  SECTION("no samples")
+  {
+    const time_series::compressed_series<timestamp, quantity<isq::length[m]>> series;
+    CHECK(series.empty());
+    CHECK(series.begin() == series.end());
+    CHECK(series.lower_bound(timestamp{0 * ms, epoch}) == series.end());
+  }
+}
+
+TEST_CASE("compressed series round trips the samples across block boundaries", "[compressed_time_series]")
+{
+  const auto times = irregular_times(100);
+  std::mt19937 gen(42);
+  std::normal_distribution<double> noise(0., 5.);
+  std::vector<raw_sample<double>> samples;
+  for (const auto t : times) samples.push_back({t, noise(gen)});
+
+  for (const std::size_t block_size : {1u, 2u, 3u, 7u, 50u, 99u, 100u, 101u}) {
+    CAPTURE(block_size);
+    CHECK(round_trips<quantity<isq::length[m]>>(samples, block_size));
+
+    // series ending exactly at a block boundary and right after it
+    for (const std::size_t count : {block_size, block_size + 1}) {
+      if (count > samples.size()) continue;
+      CAPTURE(count);
+      const std::vector<raw_sample<double>> head(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(count));
+      CHECK(round_trips<quantity<isq::length[m]>>(head, block_size));
+    }
+  }
+}
+
+TEST_CASE("compressed series keeps appending after iterators were taken", "[compressed_time_series]")
+{
+  time_series::compressed_series<timestamp, quantity<isq::length[m]>> series(4);
+  series.push_back(timestamp{0 * ms, epoch}, 1. * m);
+  const auto it = series.begin();
+  for (std::int64_t i = 1; i < 10; ++i) series.push_back(timestamp{i * 10 * ms, epoch}, static_cast<double>(-i) * m);
+
+  CHECK(std::ranges::distance(it, series.end()) == 10);
+  CHECK((*it).value.numerical_value_in(m) == 1.);
+  CHECK((*std::ranges::next(it, 9)).value.numerical_value_in(m) == -9.);
+}
+
+TEST_CASE("compressed series finds the first sample not earlier than a time point", "[compressed_time_series]")
+{
+  const auto times = irregular_times(100);
+  std::vector<raw_sample<std::int32_t>> samples;
+  for (std::size_t i = 0; i < times.size(); ++i) samples.push_back({times[i], static_cast<std::int32_t>(i)});
+
+  for (const std::size_t block_size : {1u, 4u, 7u, 4096u}) {
+    CAPTURE(block_size);
+    const auto series = make_series<quantity<isq::length[m], std::int32_t>>(samples, block_size);
+
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+      CAPTURE(i);
+      // the first sample with the same timestamp is found as the timestamps may repeat
+      const auto first = static_cast<std::size_t>(std::ranges::lower_bound(times, times[i]) - times.begin());
+      for (const std::int64_t offset : {0, -1}) {
+        const std::int64_t t = times[i] + offset;
+        if (offset != 0 && i > 0 && times[i - 1] >= t) continue;
+        const auto it = series.lower_bound(timestamp{t * ms, epoch});
+        REQUIRE(it != series.end());
+        CHECK((*it).value.numerical_value_in(m) == static_cast<std::int32_t>(first));
+        CHECK(std::ranges::distance(it, series.end()) == static_cast<std::ptrdiff_t>(samples.size() - first));
+      }
+    }
+
+    CHECK(series.lower_bound(timestamp{(times.front() - 1'000'000) * ms, epoch}) == series.begin());
+    CHECK(series.lower_bound(timestamp{(times.back() + 1) * ms, epoch}) == series.end());
+  }
+}
+
+TEST_CASE("compressed series stores a regular signal in a few bits per sample", "[compressed_time_series]")
+{
+  time_series::compressed_series<timestamp, quantity<isq::length[m]>> series;
+  for (std::int64_t i = 0; i < 4096; ++i)
+    series.push_back(timestamp{i * 1000 * ms, epoch}, static_cast<double>(i / 100) * m);
+  series.shrink_to_fit();
+
+  // 1 bit per timestamp and 1 bit per repeated value, with the occasional change of a value
+  CHECK(series.memory_usage() * 8 < series.size() * 4);
+}
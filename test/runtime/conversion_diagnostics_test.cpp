@@ -0,0 +1,177 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch_test_macros.hpp>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#endif
+#include <mp-units/systems/si.h>
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+namespace {
+
+inline constexpr struct long_unit_a final :
+    named_unit<"kilometres_named_with_a_symbol_long_enough_to_fill_more_than_half_of_a_buffer", mag<1000> * si::metre> {
+} long_unit_a;
+inline constexpr struct long_unit_b final :
+    named_unit<"kilometres_named_with_another_symbol_long_enough_to_fill_half_of_a_buffer", mag<1000> * si::metre> {
+} long_unit_b;
+inline constexpr auto long_unit = long_unit_a * long_unit_b;
+
+std::string runtime_symbol(Unit auto u)
+{
+  std::string text;
+  unit_symbol_to<char>(std::back_inserter(text), u);
+  return text;
+}
+
+std::optional<conversion_error_entry> errors_of(std::string_view from, std::string_view to, bool division = false)
+{
+  const std::vector<conversion_error_entry> errors = conversion_errors();
+  const auto it = std::ranges::find_if(errors, [&](const conversion_error_entry& e) {
+    return e.division == division && e.from_unit == from && e.to_unit == to;
+  });
+  if (it == errors.end()) return std::nullopt;
+  return *it;
+}
+
+}  // namespace
+
+TEST_CASE("conversion diagnostics", "[conversion_errors]")
+{
+  reset_conversion_errors();
+  set_conversion_errors_sampling_rate(1);
+
+  SECTION("exact conversions")
+  {
+    for (int i = 0; i < 10; ++i) [[maybe_unused]] const auto q = (i * km).in(m);
+    const auto e = errors_of("km", "m");
+    REQUIRE(e);
+    REQUIRE(e->samples == 10);
+    REQUIRE(e->inexact == 0);
+    REQUIRE(e->histogram.front() == 10);
+  }
+
+  SECTION("truncating conversions")
+  {
+    [[maybe_unused]] const auto q1 = (1500 * m).force_in(km);
+    [[maybe_unused]] const auto q2 = (2000 * m).force_in(km);
+    const auto e = errors_of("m", "km");
+    REQUIRE(e);
+    REQUIRE(e->samples == 2);
+    REQUIRE(e->inexact == 1);
+    REQUIRE(e->max_abs_error == 0.5);
+    REQUIRE(e->max_rel_error == 0.5 / 1.5);
+    REQUIRE(e->histogram.back() == 1);
+  }
+
+  SECTION("representation type conversions")
+  {
+    [[maybe_unused]] const auto q = value_cast<float>(0.1 * m);
+    const auto e = errors_of("m", "m");
+    REQUIRE(e);
+    REQUIRE(e->from_rep == "double");
+    REQUIRE(e->to_rep == "float");
+    REQUIRE(e->inexact == 1);
+    REQUIRE(e->max_rel_error < 1e-7);
+  }
+
+  SECTION("integral divisions")
+  {
+    [[maybe_unused]] const auto q1 = 7 * m / 2;
+    [[maybe_unused]] const auto q2 = 7 * m / (2 * s);
+    quantity q3 = 8 * m;
+    q3 /= 2;
+    const auto by_number = errors_of("m", "", true);
+    REQUIRE(by_number);
+    REQUIRE(by_number->samples == 2);
+    REQUIRE(by_number->inexact == 1);
+    const auto by_quantity = errors_of("m", "s", true);
+    REQUIRE(by_quantity);
+    REQUIRE(by_quantity->max_abs_error == 0.5);
+  }
+
+  SECTION("integral divisions of a number by a quantity")
+  {
+    [[maybe_unused]] const auto q1 = 7 / (2 * s);
+    [[maybe_unused]] const auto q2 = 8 / (2 * s);
+    const auto e = errors_of("", "s", true);
+    REQUIRE(e);
+    REQUIRE(e->from_rep == "int");
+    REQUIRE(e->samples == 2);
+    REQUIRE(e->inexact == 1);
+    REQUIRE(e->max_abs_error == 0.5);
+  }
+
+  SECTION("floating-point divisions are not sampled")
+  {
+    [[maybe_unused]] const auto q = 7. * m / 2;
+    REQUIRE(!errors_of("m", "", true));
+  }
+
+  SECTION("compile-time conversions are not sampled")
+  {
+    constexpr auto q = (1500 * m).force_in(km);
+    REQUIRE(q == 1 * km);
+    REQUIRE(!errors_of("m", "km"));
+  }
+
+  SECTION("sampling rate")
+  {
+    set_conversion_errors_sampling_rate(4);
+    for (int i = 0; i < 20; ++i) [[maybe_unused]] const auto q = (i * km).in(m);
+    const auto e = errors_of("km", "m");
+    REQUIRE(e);
+    REQUIRE(e->samples == 5);
+    set_conversion_errors_sampling_rate(1);
+  }
+
+  SECTION("report")
+  {
+    [[maybe_unused]] const auto q = (1500 * m).force_in(km);
+    std::ostringstream os;
+    report_conversion_errors(os);
+    REQUIRE(os.str().find("m -> km [int]: 1 samples, 1 inexact") != std::string::npos);
+  }
+
+  SECTION("renders unit symbols too long for the compile-time buffer")
+  {
+    [[maybe_unused]] const auto q1 = (1 * m2).force_in(long_unit);
+    [[maybe_unused]] const auto q2 = 7 * long_unit / 2;
+    const std::string symbol = runtime_symbol(long_unit);
+    REQUIRE(symbol.size() > 128);
+    const auto e = errors_of("m²", symbol);
+    REQUIRE(e);
+    REQUIRE(e->inexact == 1);
+    REQUIRE(errors_of(symbol, "", true));
+  }
+}
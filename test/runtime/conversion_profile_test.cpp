@@ -0,0 +1,155 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch_test_macros.hpp>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#endif
+#include <mp-units/systems/isq/space_and_time.h>
+#include <mp-units/systems/si.h>
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+namespace {
+
+inline constexpr struct long_unit_a final :
+    named_unit<"kilometres_named_with_a_symbol_long_enough_to_fill_more_than_half_of_a_buffer", mag<1000> * si::metre> {
+} long_unit_a;
+inline constexpr struct long_unit_b final :
+    named_unit<"kilometres_named_with_another_symbol_long_enough_to_fill_half_of_a_buffer", mag<1000> * si::metre> {
+} long_unit_b;
+inline constexpr auto long_unit = long_unit_a * long_unit_b;
+
+std::string runtime_symbol(Unit auto u)
+{
+  std::string text;
+  unit_symbol_to<char>(std::back_inserter(text), u);
+  return text;
+}
+
+std::uint64_t count_of(std::string_view from, std::string_view to, bool point = false)
+{
+  const std::vector<conversion_profile_entry> profile = conversion_profile();
+  const auto it = std::ranges::find_if(profile, [&](const conversion_profile_entry& e) {
+    return e.point == point && e.from_unit == from && e.to_unit == to;
+  });
+  return it == profile.end() ? 0 : it->count;
+}
+
+}  // namespace
+
+TEST_CASE("conversion profiler", "[conversion_profile]")
+{
+  reset_conversion_profile();
+
+  SECTION("counts runtime unit conversions")
+  {
+    quantity<m> sum = 0 * m;
+    for (int i = 0; i < 10; ++i) sum += (i * km).in(m);
+    REQUIRE(count_of("km", "m") == 10);
+    REQUIRE(sum == 45 * km);
+  }
+
+  SECTION("records representation types")
+  {
+    [[maybe_unused]] const auto q = value_cast<double>(42 * m);
+    const std::vector<conversion_profile_entry> profile = conversion_profile();
+    REQUIRE(profile.size() == 1);
+    REQUIRE(profile.front().from_unit == "m");
+    REQUIRE(profile.front().to_unit == "m");
+    REQUIRE(profile.front().from_rep == "int");
+    REQUIRE(profile.front().to_rep == "double");
+  }
+
+  SECTION("distinguishes quantity specifications")
+  {
+    [[maybe_unused]] const auto height = isq::height(1 * km).in(m);
+    for (int i = 0; i < 2; ++i) [[maybe_unused]] const auto width = isq::width(i * km).in(m);
+    const std::vector<conversion_profile_entry> profile = conversion_profile();
+    REQUIRE(profile.size() == 2);
+    for (const conversion_profile_entry& e : profile) {
+      REQUIRE(e.from_quantity_spec == e.to_quantity_spec);
+      REQUIRE(e.count == (e.from_quantity_spec.ends_with("height") ? 1 : 2));
+    }
+  }
+
+  SECTION("does not count compile-time conversions")
+  {
+    constexpr auto q = (1 * km).in(mm);
+    REQUIRE(q == 1'000'000 * mm);
+    REQUIRE(count_of("km", "mm") == 0);
+  }
+
+  SECTION("counts quantity point conversions once")
+  {
+    const quantity_point temp = point<deg_C>(20.);
+    [[maybe_unused]] const auto res = value_cast<quantity_point<K, si::zeroth_kelvin, float>>(temp);
+    const std::vector<conversion_profile_entry> profile = conversion_profile();
+    REQUIRE(profile.size() == 1);
+    REQUIRE(count_of("℃", "K", true) == 1);
+  }
+
+  SECTION("merges counters of all threads")
+  {
+    {
+      std::vector<std::jthread> threads;
+      for (int t = 0; t < 4; ++t)
+        threads.emplace_back([] {
+          for (int i = 0; i < 100; ++i) [[maybe_unused]] const auto q = (i * m).in(mm);
+        });
+    }
+    [[maybe_unused]] const auto q = (1 * m).in(mm);
+    REQUIRE(count_of("m", "mm") == 401);
+  }
+
+  SECTION("writes a report sorted by the number of calls")
+  {
+    for (int i = 0; i < 3; ++i) [[maybe_unused]] const auto q = (i * s).in(ms);
+    [[maybe_unused]] const auto q = (1 * h).in(s);
+    std::ostringstream os;
+    report_conversion_profile(os);
+    const std::string report = os.str();
+    REQUIRE(report.find("s -> ms") < report.find("h -> s"));
+  }
+
+  SECTION("renders unit symbols too long for the compile-time buffer")
+  {
+    const auto area = (2 * long_unit).in(m2);
+    std::ostringstream os;
+    os << 2 * long_unit;
+    const std::string symbol = runtime_symbol(long_unit);
+    REQUIRE(symbol.size() > 128);
+    REQUIRE(os.str() == "2 " + symbol);
+    REQUIRE(area == 2'000'000 * m2);
+    REQUIRE(count_of(symbol, "m²") == 1);
+  }
+}
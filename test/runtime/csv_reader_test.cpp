@@ -0,0 +1,140 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "csv_reader.h"
+#include <catch2/catch_test_macros.hpp>
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <cmath>
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/isq.h>
+#include <mp-units/systems/si.h>
+#endif
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+namespace {
+
+using time_s = quantity<isq::time[s]>;
+using time_s_int = quantity<isq::time[s], int>;
+using length_m_int = quantity<isq::length[m], int>;
+using speed = quantity<isq::speed[m / s]>;
+using temperature = quantity_point<isq::thermodynamic_temperature[K], si::zeroth_kelvin>;
+
+}  // namespace
+
+TEST_CASE("csv reader", "[csv]")
+{
+  SECTION("values are converted to the units of the columns")
+  {
+    std::istringstream is("time [s],note,speed [km/h],temp (°C)\r\n0,a,36,20\r\n1,b,72,-273.15");
+    csv::reader reader(is, csv::column<time_s>{"time"}, csv::column<speed, si::kilo<si::metre> / non_si::hour>{"speed"},
+                       csv::column<temperature, si::degree_Celsius>{"temp"});
+    decltype(reader)::batch_type batch(16);
+    REQUIRE(reader.read(batch) == 2);
+    CHECK(batch.column<0>()[1] == 1 * s);
+    CHECK(batch.column<1>()[0] == 10 * m / s);
+    CHECK(batch.column<1>()[1] == 20 * m / s);
+    CHECK(std::abs(batch.column<2>()[0].quantity_from_zero().numerical_value_in(K) - 293.15) < 1e-9);
+    CHECK(std::abs(batch.column<2>()[1].quantity_from_zero().numerical_value_in(K)) < 1e-9);
+    CHECK(reader.read(batch) == 0);
+  }
+
+  SECTION("tab-separated values are read through a small buffer in batches")
+  {
+    std::ostringstream os;
+    os << "index [s]\tlength [km]\n";
+    for (int i = 0; i < 1000; ++i) os << i << '\t' << i << ".5\n";
+    std::istringstream is(os.str());
+    csv::reader reader(is, {.threads = 4, .buffer_size = 64}, csv::column<time_s_int>{"index"},
+                       csv::column<length_m_int, si::kilo<si::metre>>{"length"});
+    decltype(reader)::batch_type batch(300);
+    int rows = 0;
+    while (const std::size_t count = reader.read(batch)) {
+      for (std::size_t i = 0; i < count; ++i, ++rows) {
+        CHECK(batch.column<0>()[i] == rows * s);
+        CHECK(batch.column<1>()[i] == (rows * 1000 + 500) * m);
+      }
+    }
+    CHECK(rows == 1000);
+  }
+
+  SECTION("empty fields of floating-point columns are NaN")
+  {
+    std::istringstream is("time [ms]\n\n1500\n \n");
+    csv::reader reader(is, csv::column<time_s, si::milli<si::second>>{"time"});
+    decltype(reader)::batch_type batch(4);
+    REQUIRE(reader.read(batch) == 2);
+    CHECK(batch.column<0>()[0] == 1.5 * s);
+    CHECK(std::isnan(batch.column<0>()[1].numerical_value_in(s)));
+  }
+
+  SECTION("integral columns reject empty fields")
+  {
+    for (const char* text : {"time [s]\n \n", "time [ms]\n \n"}) {
+      std::istringstream is(text);
+      csv::reader reader(is, csv::column<time_s_int, si::milli<si::second>>{"time"});
+      decltype(reader)::batch_type batch(4);
+      CHECK_THROWS_AS(reader.read(batch), std::invalid_argument);
+    }
+  }
+
+  SECTION("integral columns reject inexact conversions")
+  {
+    std::istringstream exact("time [ms]\n2000\n-3000\n");
+    csv::reader exact_reader(exact, csv::column<time_s_int, si::milli<si::second>>{"time"});
+    decltype(exact_reader)::batch_type batch(4);
+    REQUIRE(exact_reader.read(batch) == 2);
+    CHECK(batch.column<0>()[0] == 2 * s);
+    CHECK(batch.column<0>()[1] == -3 * s);
+
+    for (const char* text : {"time [ms]\n1500\n", "time [ms]\n1e20\n"}) {
+      std::istringstream is(text);
+      csv::reader reader(is, csv::column<time_s_int, si::milli<si::second>>{"time"});
+      CHECK_THROWS_AS(reader.read(batch), std::invalid_argument);
+    }
+  }
+
+  SECTION("invalid input fails")
+  {
+    std::istringstream missing("time [s]\n1\n");
+    CHECK_THROWS_AS(csv::reader(missing, csv::column<time_s>{"speed"}), std::invalid_argument);
+
+    std::istringstream unit("time [h]\n1\n");
+    CHECK_THROWS_AS(csv::reader(unit, csv::column<time_s>{"time"}), std::invalid_argument);
+
+    std::istringstream number("time [s]\n1x\n");
+    csv::reader reader(number, csv::column<time_s>{"time"});
+    decltype(reader)::batch_type batch(4);
+    CHECK_THROWS_AS(reader.read(batch), std::invalid_argument);
+  }
+}
@@ -0,0 +1,200 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "flat_hash_map.h"
+#include <catch2/catch_test_macros.hpp>
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/si.h>
+#endif
+
+using namespace containers;
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+namespace {
+
+// the multiplicative inverse of the Fibonacci hashing constant modulo 2^64
+constexpr std::uint64_t inverse(std::uint64_t a)
+{
+  std::uint64_t inv = a;
+  for (int i = 0; i < 5; ++i) inv *= 2 - a * inv;
+  return inv;
+}
+
+// places the key `home * 100 + id` in the slot `home` of a map with the minimum capacity of 16 slots
+struct home_slot_hash {
+  [[nodiscard]] std::size_t operator()(int key) const
+  {
+    constexpr std::uint64_t fibonacci = 0x9E3779B97F4A7C15ULL;
+    static_assert(fibonacci * inverse(fibonacci) == 1);
+    return static_cast<std::size_t>((static_cast<std::uint64_t>(key / 100) << 60) * inverse(fibonacci));
+  }
+};
+
+// puts many keys into the same home slot to create long clusters
+struct clustering_hash {
+  [[nodiscard]] std::size_t operator()(int key) const { return static_cast<std::size_t>(key / 16); }
+};
+
+template<typename Map>
+std::vector<int> keys_in_slot_order(const Map& map)
+{
+  std::vector<int> res;
+  for (const auto& entry : map) res.push_back(entry.key);
+  return res;
+}
+
+}  // namespace
+
+TEST_CASE("flat_hash_map", "[flat_hash_map]")
+{
+  using length = quantity<si::metre, int>;
+
+  SECTION("insert and find")
+  {
+    flat_hash_map<length, int> map;
+    CHECK(map.empty());
+    CHECK(!map.contains(1 * m));
+    CHECK(map.find(1 * m) == map.end());
+
+    const auto [it, inserted] = map.try_emplace(1 * m, 10);
+    CHECK(inserted);
+    CHECK(it->key == 1 * m);
+    CHECK(it->value == 10);
+    const auto [it2, inserted2] = map.try_emplace(1 * m, 20);
+    CHECK(!inserted2);
+    CHECK(it2 == it);
+    CHECK(it2->value == 10);
+
+    map[2 * m] = 20;
+    map[2 * m] += 2;
+    CHECK(map.size() == 2);
+    CHECK(map.contains(2 * m));
+    CHECK(map.find(2 * m)->value == 22);
+    CHECK(std::as_const(map).find(1 * m)->value == 10);
+  }
+
+  SECTION("erase")
+  {
+    flat_hash_map<length, int> map;
+    for (int i = 0; i < 10; ++i) map[i * m] = i;
+    CHECK(map.erase(3 * m) == 1);
+    CHECK(map.erase(3 * m) == 0);
+    CHECK(map.erase(42 * m) == 0);
+    CHECK(map.size() == 9);
+    CHECK(!map.contains(3 * m));
+    for (int i = 0; i < 10; ++i)
+      if (i != 3) CHECK(map.find(i * m)->value == i);
+    map.clear();
+    CHECK(map.empty());
+    CHECK(map.begin() == map.end());
+    CHECK(!map.contains(1 * m));
+  }
+
+  SECTION("reserve and rehash keep the entries")
+  {
+    flat_hash_map<int, int> map;
+    map.reserve(12);
+    CHECK(map.capacity() == 32);
+    map.reserve(5);
+    CHECK(map.capacity() == 32);
+    for (int i = 0; i < 1000; ++i) {
+      map[i] = 2 * i;
+      // the load factor is kept not greater than 3/4
+      CHECK(map.size() * 4 <= map.capacity() * 3);
+    }
+    CHECK(map.size() == 1000);
+    const std::size_t capacity = map.capacity();
+    CHECK(std::has_single_bit(capacity));
+    map.reserve(5000);
+    CHECK(map.capacity() > capacity);
+    for (int i = 0; i < 1000; ++i) CHECK(map.find(i)->value == 2 * i);
+    CHECK(!map.contains(1000));
+    CHECK(std::ranges::distance(map.begin(), map.end()) == 1000);
+  }
+
+  SECTION("clusters wrapping around the end of the table")
+  {
+    flat_hash_map<int, int, home_slot_hash> map;
+    // four keys with the home slot 14 occupy the slots 14, 15, 0, and 1
+    for (const int key : {1400, 1401, 1402, 1403}) map[key] = key;
+    map[0] = 0;  // home slot 0 is taken so it goes to the slot 2
+    REQUIRE(map.capacity() == 16);
+    CHECK(keys_in_slot_order(map) == std::vector{1402, 1403, 0, 1400, 1401});
+
+    // the entries after the erased one are shifted back across the end of the table
+    CHECK(map.erase(1400) == 1);
+    CHECK(keys_in_slot_order(map) == std::vector{1403, 0, 1401, 1402});
+    for (const int key : {1401, 1402, 1403, 0}) CHECK(map.find(key)->value == key);
+
+    // an entry in its home slot is not shifted back
+    map[200] = 200;  // the slot 2 is free again
+    CHECK(map.erase(1401) == 1);
+    CHECK(keys_in_slot_order(map) == std::vector{0, 200, 1402, 1403});
+    CHECK(map.erase(1402) == 1);
+    CHECK(map.erase(1403) == 1);
+    CHECK(keys_in_slot_order(map) == std::vector{0, 200});
+    CHECK(map.find(0)->value == 0);
+    CHECK(map.find(200)->value == 200);
+  }
+
+  SECTION("random operations with long clusters match std::unordered_map")
+  {
+    flat_hash_map<int, int, clustering_hash> map;
+    std::unordered_map<int, int> reference;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> key(0, 499);
+    for (int i = 0; i < 20'000; ++i) {
+      const int k = key(gen);
+      if (i % 3 == 0) {
+        CHECK(map.erase(k) == reference.erase(k));
+      } else {
+        map[k] = i;
+        reference[k] = i;
+      }
+    }
+    CHECK(map.size() == reference.size());
+    for (int k = 0; k < 500; ++k) {
+      const auto it = reference.find(k);
+      if (it == reference.end())
+        CHECK(!map.contains(k));
+      else
+        CHECK(map.find(k)->value == it->second);
+    }
+  }
+}
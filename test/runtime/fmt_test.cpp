@@ -188,6 +188,24 @@ TEST_CASE("unit formatting", "[unit][fmt]")
       CHECK(MP_UNITS_STD_FMT::format("{:ad}", kg / m / s2) == "kg/(m⋅s²)");
     }
   }
+
+  SECTION("Symbols too long to be rendered at compile time are rendered at runtime")
+  {
+    constexpr Unit auto u = km * mm * um * nm * pm * fm * kg * mg * ug * ng * pg * fg * kA * mA * uA * nA * pA * fA /
+                            (ks * ms * us * ns * ps * fs * kK * mK * uK * nK * pK * fK);
+    const std::string_view symbol =
+      "fA fg fm kA kg km µA µg µm mA mg mm nA ng nm pA pg pm "
+      "fK⁻¹ fs⁻¹ kK⁻¹ ks⁻¹ µK⁻¹ µs⁻¹ mK⁻¹ ms⁻¹ nK⁻¹ ns⁻¹ pK⁻¹ ps⁻¹";
+    REQUIRE(symbol.size() > 128);
+
+    std::ostringstream os;
+    os << 1 * u;
+    CHECK(os.str() == "1 " + std::string(symbol));
+    CHECK(MP_UNITS_STD_FMT::format("{}", u) == symbol);
+    CHECK(MP_UNITS_STD_FMT::format("{:P}", u) ==
+          "fA fg fm kA kg km uA ug um mA mg mm nA ng nm pA pg pm "
+          "fK^-1 fs^-1 kK^-1 ks^-1 uK^-1 us^-1 mK^-1 ms^-1 nK^-1 ns^-1 pK^-1 ps^-1");
+  }
 }
 
 TEST_CASE("unit formatting error handling", "[unit][fmt][exception]")
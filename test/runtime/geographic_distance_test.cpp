@@ -0,0 +1,108 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "geographic.h"
+#include "geographic_distance.h"
+#include <catch2/catch_test_macros.hpp>
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/si.h>
+#endif
+
+using namespace geographic;
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+namespace {
+
+position<double> make_position(double lat, double lon)
+{
+  return {latitude<double>{ranged_representation<double, -90, 90>{lat} * si::degree, equator},
+          longitude<double>{ranged_representation<double, -180, 180>{lon} * si::degree, prime_meridian}};
+}
+
+double in_km(distance d) { return d.numerical_value_in(si::kilo<si::metre>); }
+
+}  // namespace
+
+TEST_CASE("one-to-one distances", "[geographic]")
+{
+  // Flinders Peak -> Buninyong from Vincenty's paper
+  const position<double> flinders_peak =
+    make_position(-(37 + 57 / 60. + 3.72030 / 3600), 144 + 25 / 60. + 29.52440 / 3600);
+  const position<double> buninyong =
+    make_position(-(37 + 39 / 60. + 10.15610 / 3600), 143 + 55 / 60. + 35.38390 / 3600);
+  CHECK(std::abs(in_km(vincenty_distance(flinders_peak, buninyong)) - 54.972271) < 1e-6);
+  CHECK(std::abs(in_km(haversine_distance(flinders_peak, buninyong)) - 54.972271) < 0.2);
+
+  CHECK(in_km(vincenty_distance(buninyong, buninyong)) == 0);
+  CHECK(in_km(haversine_distance(buninyong, buninyong)) == 0);
+
+  // a quarter of the meridian
+  CHECK(std::abs(in_km(vincenty_distance(make_position(0, 0), make_position(90, 0))) - 10'001.965729) < 1e-5);
+}
+
+TEST_CASE("nearly antipodal points fall back to the spherical distance", "[geographic]")
+{
+  const position<double> from = make_position(0, 0);
+  const position<double> to = make_position(0.5, 179.7);
+  const auto p1 = geographic::detail::make_point_terms(from);
+  const auto p2 = geographic::detail::make_point_terms(to);
+  REQUIRE_FALSE(
+    geographic::detail::vincenty_distance_km(p1.lon, p1.sin_u, p1.cos_u, p2.lon, p2.sin_u, p2.cos_u).converged);
+
+  const distance d = vincenty_distance(from, to);
+  CHECK(std::isfinite(in_km(d)));
+  CHECK(d == haversine_distance(from, to));
+}
+
+TEST_CASE("batch distances match the one-to-one ones", "[geographic]")
+{
+  const position_array<double> from = {make_position(54.24772, 18.6745), make_position(-33.9, 151.2)};
+  const position_array<double> to = {make_position(53.52442, 18.84947), make_position(40.7, -74.),
+                                     make_position(0, 0), make_position(33.9, -28.8)};
+
+  std::vector<distance> row(to.size());
+  haversine_distance(from[0], to, row);
+  for (std::size_t i = 0; i < to.size(); ++i) CHECK(row[i] == haversine_distance(from[0], to[i]));
+  vincenty_distance(from[0], to, row);
+  for (std::size_t i = 0; i < to.size(); ++i) CHECK(row[i] == vincenty_distance(from[0], to[i]));
+
+  std::vector<distance> matrix(from.size() * to.size());
+  haversine_distance(from, to, matrix);
+  for (std::size_t r = 0; r < from.size(); ++r)
+    for (std::size_t i = 0; i < to.size(); ++i)
+      CHECK(std::abs(in_km(matrix[r * to.size() + i]) - in_km(haversine_distance(from[r], to[i]))) < 1e-9);
+  vincenty_distance(from, to, matrix);
+  for (std::size_t r = 0; r < from.size(); ++r)
+    for (std::size_t i = 0; i < to.size(); ++i)
+      CHECK(std::abs(in_km(matrix[r * to.size() + i]) - in_km(vincenty_distance(from[r], to[i]))) < 1e-9);
+}
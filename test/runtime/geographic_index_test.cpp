@@ -0,0 +1,138 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "geographic.h"
+#include "geographic_index.h"
+#include <catch2/catch_test_macros.hpp>
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <random>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/si.h>
+#endif
+
+using namespace geographic;
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+namespace {
+
+position<long double> make_position(long double lat, long double lon)
+{
+  return {latitude<long double>{ranged_representation<long double, -90, 90>{lat} * si::degree, equator},
+          longitude<long double>{ranged_representation<long double, -180, 180>{lon} * si::degree, prime_meridian}};
+}
+
+// positions spread over the globe with a part of them close to the antimeridian and the poles
+std::vector<position<long double>> random_positions(std::size_t count, unsigned seed)
+{
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<long double> lat(-90., 90.);
+  std::uniform_real_distribution<long double> lon(-180., 180.);
+  std::uniform_real_distribution<long double> edge(-3., 3.);
+  std::vector<position<long double>> res;
+  res.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    switch (i % 4) {
+      case 0:
+        res.push_back(make_position(lat(gen), std::clamp(180.L + edge(gen), -180.L, 180.L)));
+        break;
+      case 1:
+        res.push_back(make_position(lat(gen), std::clamp(-180.L + edge(gen), -180.L, 180.L)));
+        break;
+      case 2:
+        res.push_back(make_position(std::clamp(90.L + edge(gen), -90.L, 90.L), lon(gen)));
+        break;
+      default:
+        res.push_back(make_position(lat(gen), lon(gen)));
+    }
+  }
+  return res;
+}
+
+}  // namespace
+
+TEST_CASE("spatial index matches a brute-force search", "[geographic]")
+{
+  const std::vector<position<long double>> points = random_positions(10'000, 1);
+  std::vector<spatial_index<std::size_t>::entry> entries;
+  for (std::size_t i = 0; i < points.size(); ++i) entries.push_back({i, points[i]});
+  const std::vector<position<long double>> queries = random_positions(200, 2);
+  const std::array radii = {100. * km, 700. * km};
+
+  // expected[query][radius]
+  std::vector<std::array<std::vector<std::size_t>, radii.size()>> expected(queries.size());
+  for (std::size_t q = 0; q < queries.size(); ++q)
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      const distance d = spherical_distance(queries[q], points[i]);
+      for (std::size_t r = 0; r < radii.size(); ++r)
+        if (d <= radii[r]) expected[q][r].push_back(i);
+    }
+
+  for (const auto cell_size : {500. * km, 1000. * km, 3000. * km}) {
+    spatial_index<std::size_t> index(cell_size);
+    index.build(entries, 4);
+    REQUIRE(index.size() == points.size());
+    for (std::size_t q = 0; q < queries.size(); ++q)
+      for (std::size_t r = 0; r < radii.size(); ++r) {
+        std::vector<std::size_t> found;
+        for (const auto& m : index.within_radius(queries[q], radii[r])) found.push_back(m.id);
+        std::ranges::sort(found);
+        CHECK(found == expected[q][r]);
+      }
+  }
+}
+
+TEST_CASE("spatial index updates", "[geographic]")
+{
+  spatial_index<int> index(100. * km);
+  index.insert({1, make_position(10., 179.9)});
+  index.insert({2, make_position(10., -179.9)});
+  CHECK(index.within_radius(make_position(10., 180.), 50. * km).size() == 2);
+
+  SECTION("inserting an existing identifier replaces its entry")
+  {
+    index.insert({1, make_position(-45., 0.)});
+    CHECK(index.size() == 2);
+    CHECK(index.within_radius(make_position(10., 180.), 50. * km).size() == 1);
+    REQUIRE(index.within_radius(make_position(-45., 0.), 50. * km).size() == 1);
+    CHECK(index.remove(1));
+    CHECK(index.within_radius(make_position(-45., 0.), 50. * km).empty());
+    CHECK(index.size() == 1);
+  }
+
+  SECTION("removed identifiers are not found")
+  {
+    CHECK(index.remove(2));
+    CHECK_FALSE(index.remove(2));
+    CHECK(index.within_radius(make_position(10., 180.), 50. * km).size() == 1);
+  }
+}
@@ -0,0 +1,204 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "glide_computer_lib.h"
+#include <catch2/catch_test_macros.hpp>
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/international.h>
+#include <mp-units/systems/si.h>
+#endif
+
+using namespace geographic;
+using namespace glide_computer;
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+namespace {
+
+const std::array gliders = {glider{"SZD-30 Pirat", {{{83 * km / h, -0.7389 * m / s}}}},
+                            glider{"SZD-51 Junior", {{{80 * km / h, -0.6349 * m / s}}}},
+                            glider{"SZD-56 Diana", {{{110 * km / h, -0.63657 * m / s}}}}};
+const std::array conditions = {weather{1900 * m, 4.3 * m / s}, weather{1550 * m, 2.8 * m / s},
+                               weather{850 * m, 1.8 * m / s}};
+const std::array margins = {safety{200 * m}, safety{500 * m}};
+const aircraft_tow tow = {400 * m, 1.6 * m / s};
+
+std::array<waypoint, 2> get_waypoints()
+{
+  using namespace geographic::literals;
+  using namespace mp_units::international::unit_symbols;
+  return {waypoint{"EPPR", {54.24772_N, 18.6745_E}, mean_sea_level + 16. * ft},
+          waypoint{"EPGI", {53.52442_N, 18.84947_E}, mean_sea_level + 115. * ft}};
+}
+
+std::vector<scenario> get_scenarios()
+{
+  std::vector<scenario> res;
+  for (const glider& g : gliders)
+    for (const weather& w : conditions)
+      for (const safety& s : margins) res.push_back({g, w, s, tow});
+  return res;
+}
+
+bool same_point(const flight_point& lhs, const flight_point& rhs)
+{
+  return lhs.ts == rhs.ts && lhs.alt == rhs.alt && lhs.leg_idx == rhs.leg_idx && lhs.dist == rhs.dist;
+}
+
+bool same_estimate(const flight_estimate& lhs, const flight_estimate& rhs)
+{
+  if (lhs.completed != rhs.completed || lhs.phases.size() != rhs.phases.size()) return false;
+  for (std::size_t i = 0; i < lhs.phases.size(); ++i)
+    if (lhs.phases[i].type != rhs.phases[i].type || !same_point(lhs.phases[i].begin, rhs.phases[i].begin) ||
+        !same_point(lhs.phases[i].end, rhs.phases[i].end))
+      return false;
+  return true;
+}
+
+}  // namespace
+
+TEST_CASE("batch estimation of glide computer scenarios", "[glide_computer]")
+{
+  const auto waypoints = get_waypoints();
+  const task t = {waypoints[0], waypoints[1], waypoints[0]};
+  const timestamp start_ts(std::chrono::system_clock::now());
+  const std::vector<scenario> scenarios = get_scenarios();
+
+  std::vector<flight_estimate> expected;
+  for (const scenario& sc : scenarios) expected.push_back(estimate(start_ts, t, sc));
+
+  SECTION("results equal the single scenario estimates in the order of the scenarios")
+  {
+    for (const unsigned threads : {0u, 1u, 4u, static_cast<unsigned>(scenarios.size()) + 5}) {
+      const std::vector<flight_estimate> res = estimate(start_ts, t, std::span(scenarios), threads);
+      REQUIRE(res.size() == scenarios.size());
+      for (std::size_t i = 0; i < res.size(); ++i) CHECK(same_estimate(res[i], expected[i]));
+    }
+  }
+
+  SECTION("no scenarios")
+  {
+    CHECK(estimate(start_ts, t, std::span<const scenario>{}, 4).empty());
+  }
+
+  SECTION("completed flights reach the finish")
+  {
+    for (const flight_estimate& res : expected) {
+      if (!res.completed) continue;
+      REQUIRE(res.phases.size() >= 3);
+      CHECK(res.phases.front().type == flight_phase::kind::tow);
+      CHECK(res.phases.back().type == flight_phase::kind::final_glide);
+      CHECK(abs(res.total_distance() - t.get_distance()) < 1 * mm);
+      CHECK(res.phases.back().end.alt == t.get_finish().alt);
+    }
+  }
+
+  SECTION("thermals weaker than the sink rate of the glider")
+  {
+    const weather weak = {1500 * m, 0.5 * m / s};
+    const std::array weak_scenarios = {scenario{gliders[0], weak, margins[0], tow},
+                                       scenario{gliders[1], weak, margins[0], tow}};
+    for (const unsigned threads : {1u, 2u}) {
+      const std::vector<flight_estimate> res = estimate(start_ts, t, std::span(weak_scenarios), threads);
+      REQUIRE(res.size() == weak_scenarios.size());
+      for (const flight_estimate& r : res) {
+        CHECK(!r.completed);
+        REQUIRE(r.phases.size() == 2);
+        CHECK(r.phases[0].type == flight_phase::kind::tow);
+        CHECK(r.phases[1].type == flight_phase::kind::glide);
+        CHECK(r.total_distance() < t.get_distance());
+      }
+    }
+  }
+}
+
+
+TEST_CASE("glides over a terrain profile", "[glide_computer]")
+{
+  using namespace geographic::literals;
+
+  // flat terrain at 100 m with a 600 m ridge between 0.3 and 0.35 degrees of longitude east
+  const terrain_grid_info info = {0. * deg, 0. * deg, 0.01 * deg, 11, 101, 64};
+  std::vector<terrain_sample> samples;
+  for (std::uint32_t r = 0; r < info.rows; ++r)
+    for (std::uint32_t c = 0; c < info.cols; ++c) {
+      const auto alt = static_cast<std::int16_t>(c >= 30 && c <= 35 ? 600 : 100);
+      samples.emplace_back(alt * isq::altitude[si::metre], mean_sea_level);
+    }
+  std::ostringstream os;
+  write_terrain_grid(os, info, samples);
+  const std::string contents = os.str();
+  std::vector<std::uint64_t> storage((contents.size() + 7) / 8);
+  std::memcpy(storage.data(), contents.data(), contents.size());
+  const terrain_grid grid(std::span(reinterpret_cast<const std::byte*>(storage.data()), contents.size()));
+  terrain_cache cache(grid, 4);
+
+  const std::array waypoints = {waypoint{"A", {0.05_N, 0.1_E}, mean_sea_level + 100. * m},
+                                waypoint{"B", {0.05_N, 0.9_E}, mean_sea_level + 100. * m}};
+  task t = {waypoints[0], waypoints[1], waypoints[0]};
+  t.set_terrain(cache, 0.5 * km);
+
+  // the tow ends high enough to reach the ridge but not to pass it with the safety margin
+  const glider& g = gliders[0];
+  const safety s = {200 * m};
+  const scenario sc = {g, conditions[0], s, aircraft_tow{1500 * m, 1.6 * m / s}};
+  const flight_estimate res = estimate(timestamp(std::chrono::system_clock::now()), t, sc);
+  REQUIRE(res.phases.size() >= 2);
+  const flight_phase& glide = res.phases[1];
+  REQUIRE(glide.type == flight_phase::kind::glide);
+
+  // the glide ends over the ridge where the glide line meets the minimum safe altitude
+  const auto ridge_begin = spherical_distance(waypoints[0].pos, position<long double>{0.05_N, 0.3_E});
+  const auto ridge_end = spherical_distance(waypoints[0].pos, position<long double>{0.05_N, 0.35_E});
+  CHECK(glide.end.dist > ridge_begin);
+  CHECK(glide.end.dist < ridge_end);
+  CHECK(abs(glide.end.alt - (mean_sea_level + 800. * m)) < 1 * m);
+  CHECK(abs(agl(glide.end.alt, terrain_level_alt(t, glide.end)) - s.min_agl_height) < 1 * m);
+  const height height_loss = quantity_cast<isq::height>((glide.end.dist - glide.begin.dist) / glide_ratio(g.polar[0]));
+  CHECK(abs(glide.begin.alt - height_loss - glide.end.alt) < 1 * mm);
+
+  // the glider never drops below the minimum safe altitude on the way
+  for (int i = 0; i <= 100; ++i) {
+    const distance dist = glide.begin.dist + (glide.end.dist - glide.begin.dist) * (i / 100.);
+    const geographic::msl_altitude alt =
+      glide.begin.alt - quantity_cast<isq::height>((dist - glide.begin.dist) / glide_ratio(g.polar[0]));
+    const flight_point pos = {glide.begin.ts, alt, t.get_leg_index(dist), dist};
+    CHECK(agl(alt, terrain_level_alt(t, pos)) > s.min_agl_height - 1 * m);
+  }
+}
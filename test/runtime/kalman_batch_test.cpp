@@ -0,0 +1,133 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "kalman.h"
+#include <catch2/catch_test_macros.hpp>
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/isq/space_and_time.h>
+#include <mp-units/systems/si.h>
+#endif
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+namespace {
+
+using gain = quantity<one>;
+using qp1 = quantity_point<isq::displacement[m]>;
+using qp2 = quantity_point<isq::velocity[m / s]>;
+using qp3 = quantity_point<isq::acceleration[m / s2]>;
+
+const std::vector<qp1> measured = {qp1{49.95 * m}, qp1{49.967 * m}, qp1{50.1 * m}, qp1{50.106 * m}};
+const std::vector<gain> gain1 = {0.2 * one, 0.4 * one, 0.6 * one, 0.8 * one};
+const std::vector<gain> gain2 = {0.1 * one, 0.05 * one, 0.025 * one, 0.0125 * one};
+const std::vector<gain> gain3 = {0.01 * one, 0.02 * one, 0.03 * one, 0.04 * one};
+
+double value(QuantityPoint auto qp, Unit auto u) { return qp.quantity_from_zero().numerical_value_in(u); }
+
+double value(Quantity auto q) { return q.numerical_value_in(q.unit); }
+
+}  // namespace
+
+TEST_CASE("batch state update matches the update of every track", "[kalman]")
+{
+  const std::size_t n = measured.size();
+  const double x1 = 50.;
+  const double x2 = 2.;
+  const double x3 = 0.5;
+  const double dt = 5.;
+
+  SECTION("one state")
+  {
+    kalman::system_state_batch<qp1> batch(n, kalman::system_state<qp1>{qp1{x1 * m}});
+    kalman::state_update(batch, measured, gain1);
+
+    REQUIRE(batch.size() == n);
+    for (std::size_t i = 0; i < n; ++i) {
+      const double residual = value(measured[i], m) - x1;
+      CHECK(value(get<0>(batch)[i], m) == x1 + value(gain1[i]) * residual);
+    }
+  }
+
+  SECTION("two states")
+  {
+    kalman::system_state_batch<qp1, qp2> batch(n, kalman::system_state<qp1, qp2>{qp1{x1 * m}, qp2{x2 * (m / s)}});
+    kalman::state_update(batch, measured, std::array{gain1, gain2}, dt * s);
+
+    for (std::size_t i = 0; i < n; ++i) {
+      const double residual = value(measured[i], m) - x1;
+      CHECK(value(get<0>(batch)[i], m) == std::fma(value(gain1[i]), residual, x1));
+      CHECK(value(get<1>(batch)[i], m / s) == std::fma(value(gain2[i]), residual / dt, x2));
+    }
+  }
+
+  SECTION("three states")
+  {
+    kalman::system_state_batch<qp1, qp2, qp3> batch(
+      n, kalman::system_state<qp1, qp2, qp3>{qp1{x1 * m}, qp2{x2 * (m / s)}, qp3{x3 * (m / s2)}});
+    kalman::state_update(batch, measured, std::array{gain1, gain2, gain3}, dt * s);
+
+    for (std::size_t i = 0; i < n; ++i) {
+      const double residual = value(measured[i], m) - x1;
+      CHECK(value(get<0>(batch)[i], m) == std::fma(value(gain1[i]), residual, x1));
+      CHECK(value(get<1>(batch)[i], m / s) == std::fma(value(gain2[i]), residual / dt, x2));
+      CHECK(value(get<2>(batch)[i], m / s2) == std::fma(value(gain3[i]), residual / (dt * dt / 2), x3));
+    }
+  }
+
+  SECTION("the tracks can be read and written individually")
+  {
+    kalman::system_state_batch<qp1, qp2> batch(n, kalman::system_state<qp1, qp2>{qp1{x1 * m}, qp2{x2 * (m / s)}});
+    batch.set(1, kalman::system_state<qp1, qp2>{qp1{42. * m}, qp2{-1. * (m / s)}});
+
+    CHECK(value(get<0>(batch[0]), m) == x1);
+    CHECK(value(get<0>(batch[1]), m) == 42.);
+    CHECK(value(get<1>(batch[1]), m / s) == -1.);
+  }
+}
+
+TEST_CASE("batch gain and covariance update match the update of every track", "[kalman]")
+{
+  std::vector<quantity<m2>> uncertainty = {225. * m2, 100. * m2, 25. * m2, 4. * m2};
+  const std::vector<quantity<m2>> measurement_uncertainty = {25. * m2, 25. * m2, 25. * m2, 25. * m2};
+  const std::vector<quantity<m2>> initial = uncertainty;
+
+  std::vector<gain> k(uncertainty.size());
+  kalman::kalman_gain(uncertainty, measurement_uncertainty, k);
+  kalman::covariance_update(uncertainty, k);
+
+  for (std::size_t i = 0; i < k.size(); ++i) {
+    CHECK(value(k[i]) == value(kalman::kalman_gain(initial[i], measurement_uncertainty[i])));
+    CHECK(value(uncertainty[i]) == value(kalman::covariance_update(initial[i], k[i])));
+  }
+}
@@ -0,0 +1,105 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "kinematic_filter.h"
+#include <catch2/catch_test_macros.hpp>
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <cmath>
+#include <concepts>
+#include <tuple>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/si.h>
+#endif
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+namespace {
+
+using filter = kalman::kinematic_filter<si::metre, si::second, 3>;
+
+static_assert(std::same_as<filter::state_type<0>, quantity<m>>);
+static_assert(std::same_as<filter::state_type<1>, quantity<m / s>>);
+static_assert(std::same_as<filter::state_type<2>, quantity<m / pow<2>(s)>>);
+static_assert(std::same_as<filter::covariance_type<0, 0>, quantity<pow<2>(m)>>);
+static_assert(std::same_as<filter::covariance_type<1, 2>, quantity<pow<2>(m) / pow<3>(s)>>);
+static_assert(std::same_as<filter::gain_type<0>, quantity<one>>);
+static_assert(std::same_as<filter::gain_type<1>, quantity<one / s>>);
+
+bool near(double lhs, double rhs, double tolerance = 1e-12) { return std::abs(lhs - rhs) <= tolerance; }
+
+}  // namespace
+
+TEST_CASE("one-state filter matches the scalar update equations", "[kalman]")
+{
+  kalman::kinematic_filter<si::metre, si::second, 1> f(std::tuple{60. * m}, std::tuple{225. * m2});
+  f.update(48.54 * m, 25. * m2);
+
+  // K = p / (p + r), x = x + K * (z - x), p = (1 - K) * p
+  const double k = 225. / (225. + 25.);
+  CHECK(near(f.gain<0>().numerical_value_in(one), k));
+  CHECK(near(f.state<0>().numerical_value_in(m), 60. + k * (48.54 - 60.)));
+  CHECK(near(f.covariance<0, 0>().numerical_value_in(m2), (1. - k) * 225.));
+}
+
+TEST_CASE("prediction extrapolates the state and the covariance", "[kalman]")
+{
+  kalman::kinematic_filter<si::metre, si::second, 2> f(std::tuple{1. * m, 3. * (m / s)},
+                                                      std::tuple{4. * m2, 2. * (m2 / s2)});
+  f.predict(2. * s, 0.5 * (m2 / s2));
+
+  CHECK(near(f.state<0>().numerical_value_in(m), 7.));
+  CHECK(near(f.state<1>().numerical_value_in(m / s), 3.));
+
+  // P = F * P * F^T + G * G^T * q with F = [[1, dt], [0, 1]] and G = [dt, 1]
+  CHECK(near(f.covariance<0, 0>().numerical_value_in(m2), 4. + 4. * 2. + 4. * 0.5));
+  CHECK(near(f.covariance<0, 1>().numerical_value_in(m2 / s), 2. * 2. + 2. * 0.5));
+  CHECK(near(f.covariance<1, 0>().numerical_value_in(m2 / s), 2. * 2. + 2. * 0.5));
+  CHECK(near(f.covariance<1, 1>().numerical_value_in(m2 / s2), 2. + 0.5));
+}
+
+TEST_CASE("filter converges to a constant acceleration motion", "[kalman]")
+{
+  filter f(std::tuple{0. * m, 0. * (m / s), 0. * (m / s2)},
+           std::tuple{100. * m2, 100. * (m2 / s2), 100. * (m2 / pow<4>(s))});
+
+  const quantity dt = 0.1 * s;
+  const quantity x0 = 5. * m;
+  const quantity v0 = 2. * (m / s);
+  const quantity a = 0.5 * (m / s2);
+  for (int i = 1; i <= 500; ++i) {
+    const quantity t = i * dt;
+    f.predict(dt, 1e-9 * (m2 / pow<4>(s)));
+    f.update(x0 + v0 * t + a * t * t / 2., 0.01 * m2);
+  }
+
+  const quantity t = 500 * dt;
+  CHECK(near(f.state<0>().numerical_value_in(m), (x0 + v0 * t + a * t * t / 2.).numerical_value_in(m), 1e-3));
+  CHECK(near(f.state<1>().numerical_value_in(m / s), (v0 + a * t).numerical_value_in(m / s), 1e-3));
+  CHECK(near(f.state<2>().numerical_value_in(m / s2), a.numerical_value_in(m / s2), 1e-3));
+}
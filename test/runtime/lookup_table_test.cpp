@@ -0,0 +1,214 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "lookup_table.h"
+#include <catch2/catch_test_macros.hpp>
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/si.h>
+#endif
+
+using namespace tables;
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+namespace {
+
+using speed = quantity<si::metre / si::second>;
+using speed_kmh = quantity<si::kilo<si::metre> / si::hour>;
+using length = quantity<si::metre>;
+using duration = quantity<si::second>;
+
+bool near(double lhs, double rhs) { return std::abs(lhs - rhs) <= 1e-12 * std::max(1., std::abs(rhs)); }
+
+template<typename Rep>
+bool same_cell(cell<Rep> c, std::size_t index, Rep fraction)
+{
+  return c.index == index && near(c.fraction, fraction);
+}
+
+bool near(length lhs, length rhs) { return near(lhs.numerical_value_in(m), rhs.numerical_value_in(m)); }
+
+// bilinear in both arguments so the interpolation reproduces it exactly inside of every cell
+constexpr double f(double x, double y) { return 1. + 2. * x + 10. * y + x * y; }
+
+}  // namespace
+
+TEST_CASE("uniform_axis", "[lookup_table]")
+{
+  const uniform_axis<speed, 5> axis(10. * m / s, 50. * m / s);
+  CHECK(axis[0] == 10. * m / s);
+  CHECK(axis[4] == 50. * m / s);
+
+  SECTION("at and beyond both ends")
+  {
+    CHECK(same_cell(axis.locate(10. * m / s), 0, 0.));
+    CHECK(same_cell(axis.locate(5. * m / s), 0, 0.));
+    CHECK(same_cell(axis.locate(-100. * m / s), 0, 0.));
+    CHECK(same_cell(axis.locate(50. * m / s), 3, 1.));
+    CHECK(same_cell(axis.locate(1000. * m / s), 3, 1.));
+  }
+
+  SECTION("inside")
+  {
+    CHECK(same_cell(axis.locate(25. * m / s), 1, 0.5));
+    CHECK(same_cell(axis.locate(42.5 * m / s), 3, 0.25));
+  }
+
+  SECTION("arguments in other units")
+  {
+    CHECK(same_cell(axis.locate(90. * km / h), 1, 0.5));  // 25 m/s
+    CHECK(same_cell(axis.locate(speed_kmh{153., km / h}), 3, 0.25));  // 42.5 m/s
+    CHECK(same_cell(axis.locate(1000. * km / h), 3, 1.));
+  }
+}
+
+TEST_CASE("nonuniform_axis", "[lookup_table]")
+{
+  const nonuniform_axis<speed, 5> axis({0. * m / s, 1. * m / s, 3. * m / s, 7. * m / s, 15. * m / s});
+  CHECK(axis[2] == 3. * m / s);
+
+  SECTION("at and beyond both ends")
+  {
+    CHECK(same_cell(axis.locate(0. * m / s), 0, 0.));
+    CHECK(same_cell(axis.locate(-1. * m / s), 0, 0.));
+    CHECK(same_cell(axis.locate(15. * m / s), 3, 1.));
+    CHECK(same_cell(axis.locate(20. * m / s), 3, 1.));
+  }
+
+  SECTION("inside")
+  {
+    CHECK(same_cell(axis.locate(0.5 * m / s), 0, 0.5));
+    CHECK(same_cell(axis.locate(5. * m / s), 2, 0.5));
+    CHECK(same_cell(axis.locate(13. * m / s), 3, 0.75));
+    CHECK(same_cell(axis.locate(18. * km / h), 2, 0.5));  // 5 m/s
+  }
+
+  SECTION("the hint is reused and updated")
+  {
+    std::size_t hint = 0;
+    CHECK(same_cell(axis.locate(0.5 * m / s, hint), 0, 0.5));
+    CHECK(hint == 0);
+    // the next cell
+    CHECK(same_cell(axis.locate(2. * m / s, hint), 1, 0.5));
+    CHECK(hint == 1);
+    // the previous cell
+    CHECK(same_cell(axis.locate(0.25 * m / s, hint), 0, 0.25));
+    CHECK(hint == 0);
+    // a binary search
+    CHECK(same_cell(axis.locate(11. * m / s, hint), 3, 0.5));
+    CHECK(hint == 3);
+    CHECK(same_cell(axis.locate(30. * m / s, hint), 3, 1.));
+    CHECK(hint == 3);
+    CHECK(same_cell(axis.locate(-1. * m / s, hint), 0, 0.));
+    CHECK(hint == 0);
+    // an out-of-range hint is clamped to the last cell
+    hint = 42;
+    CHECK(same_cell(axis.locate(2. * m / s, hint), 1, 0.5));
+    CHECK(hint == 1);
+  }
+}
+
+TEST_CASE("lookup_table", "[lookup_table]")
+{
+  using x_axis = uniform_axis<length, 3>;
+  using y_axis = nonuniform_axis<duration, 4>;
+  const x_axis xs(0. * m, 2. * m);
+  const y_axis ys({0. * s, 1. * s, 3. * s, 4. * s});
+  std::array<length, x_axis::size * y_axis::size> values{};
+  for (std::size_t i = 0; i < x_axis::size; ++i)
+    for (std::size_t j = 0; j < y_axis::size; ++j)
+      values[i * y_axis::size + j] = f(xs[i].numerical_value_in(m), ys[j].numerical_value_in(s)) * m;
+  const lookup_table<length, x_axis, y_axis> table2d(xs, ys, values);
+
+  SECTION("linear interpolation")
+  {
+    constexpr lookup_table<length, uniform_axis<speed, 3>> table(uniform_axis<speed, 3>(0. * m / s, 10. * m / s),
+                                                                 {0. * m, 100. * m, 300. * m});
+    static_assert(table(5. * m / s) == 100. * m);
+    CHECK(near(table(2.5 * m / s), 50. * m));
+    CHECK(near(table(7.5 * m / s), 200. * m));
+    CHECK(near(table(27. * km / h), 200. * m));  // 7.5 m/s
+    CHECK(table(-1. * m / s) == 0. * m);
+    CHECK(table(11. * m / s) == 300. * m);
+  }
+
+  SECTION("bilinear interpolation")
+  {
+    CHECK(table2d.axis<0>()[1] == 1. * m);
+    CHECK(table2d.axis<1>()[2] == 3. * s);
+    for (const double x : {0., 0.25, 1., 1.5, 2.})
+      for (const double y : {0., 0.5, 1., 2., 3.5, 4.})
+        CHECK(near(table2d(x * m, y * s), f(x, y) * m));
+    CHECK(near(table2d(50. * si::centi<si::metre>, 500. * si::milli<si::second>), f(0.5, 0.5) * m));
+    // clamped to the edges
+    CHECK(near(table2d(-1. * m, 5. * s), f(0., 4.) * m));
+    CHECK(near(table2d(3. * m, -5. * s), f(2., 0.) * m));
+  }
+
+  SECTION("cursor")
+  {
+    lookup_table<length, x_axis, y_axis>::cursor cursor(table2d);
+    for (double t = 0.; t <= 4.; t += 0.125) {
+      const length x = 0.5 * t * m;
+      const duration y = (4. - t) * s;
+      CHECK(near(cursor(x, y), table2d(x, y)));
+    }
+    // a jump back to the beginning needs a binary search
+    CHECK(near(cursor(0. * m, 0. * s), table2d(0. * m, 0. * s)));
+  }
+
+  SECTION("batch evaluation equals the scalar one")
+  {
+    // more than one block of the batch buffer
+    std::vector<speed_kmh> args;
+    std::vector<length> xs2;
+    std::vector<duration> ys2;
+    for (int i = 0; i < 150; ++i) {
+      args.push_back((i - 10) * 0.3 * km / h);
+      xs2.push_back((i % 23) * 0.1 * m);
+      ys2.push_back((149 - i) * 0.03 * s);
+    }
+
+    const lookup_table<length, nonuniform_axis<speed, 4>> table1d(
+      nonuniform_axis<speed, 4>({0. * m / s, 2. * m / s, 5. * m / s, 11. * m / s}), {0. * m, 1. * m, 8. * m, 9. * m});
+    std::vector<length> out1(args.size());
+    table1d.evaluate(std::span<const speed_kmh>(args), std::span(out1));
+    for (std::size_t i = 0; i < args.size(); ++i) CHECK(near(out1[i], table1d(args[i])));
+
+    std::vector<length> out2(xs2.size());
+    table2d.evaluate(std::span<const length>(xs2), std::span<const duration>(ys2), std::span(out2));
+    for (std::size_t i = 0; i < xs2.size(); ++i) CHECK(near(out2[i], table2d(xs2[i], ys2[i])));
+  }
+}
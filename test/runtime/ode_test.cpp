@@ -0,0 +1,120 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "ode.h"
+#include <catch2/catch_test_macros.hpp>
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <cmath>
+#include <limits>
+#include <span>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/si.h>
+#endif
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+namespace {
+
+using length = quantity<m>;
+using duration = quantity<s>;
+
+// exponential decay `y' = -y / tau`
+const auto decay = [](duration, const length& y) { return -y / (2. * s); };
+
+double exact_decay(double y0, double t) { return y0 * std::exp(-t / 2.); }
+
+}  // namespace
+
+TEST_CASE("fixed step integration", "[ode]")
+{
+  const length y = ode::integrate_rk4(decay, 1. * m, 0. * s, 3. * s, 0.01 * s);
+  CHECK(std::abs(y.numerical_value_in(m) - exact_decay(1., 3.)) < 1e-9);
+}
+
+TEST_CASE("adaptive step integration", "[ode]")
+{
+  SECTION("reaches the end of the interval within the tolerance")
+  {
+    const auto res = ode::integrate_rk45(decay, 1. * m, 0. * s, 3. * s, 0.1 * s, 1e-9 * m, 1e-9);
+    REQUIRE(res);
+    CHECK(res.time == 3. * s);
+    CHECK(res.accepted > 0);
+    CHECK(std::abs(res.state.numerical_value_in(m) - exact_decay(1., 3.)) < 1e-7);
+  }
+
+  SECTION("the shortened last step does not reduce the step to continue with")
+  {
+    const auto first = ode::integrate_rk45(decay, 1. * m, 0. * s, 1.000001 * s, 0.5 * s, 1e-6 * m, 1e-6);
+    REQUIRE(first);
+    CHECK(first.step > 0.01 * s);
+    const auto second = ode::integrate_rk45(decay, first.state, first.time, 3. * s, first.step, 1e-6 * m, 1e-6);
+    REQUIRE(second);
+    CHECK(std::abs(second.state.numerical_value_in(m) - exact_decay(1., 3.)) < 1e-5);
+  }
+
+  SECTION("non-finite error stops the integration")
+  {
+    const auto nan = [](duration t, const length&) {
+      return t > 1. * s ? std::numeric_limits<double>::quiet_NaN() * m / s : 1. * m / s;
+    };
+    const auto res = ode::integrate_rk45(nan, 0. * m, 0. * s, 3. * s, 0.1 * s, 1e-6 * m, 1e-6);
+    CHECK(res.status == ode::rk45_status::invalid_error);
+    CHECK(res.time <= 1. * s);
+  }
+
+  SECTION("singularity stops the integration at the minimum step")
+  {
+    // `y' = 1 / (1 s - t)` diverges at 1 s
+    const auto singular = [](duration t, const length&) { return 1. * m / (1. * s - t); };
+    const auto res =
+      ode::integrate_rk45(singular, 0. * m, 0. * s, 2. * s, 0.1 * s, 1e-6 * m, 1e-6, {.h_min = 1e-6 * s});
+    CHECK(res.status == ode::rk45_status::step_too_small);
+    CHECK(res.time < 1. * s);
+  }
+
+  SECTION("the number of steps is limited")
+  {
+    const auto res =
+      ode::integrate_rk45(decay, 1. * m, 0. * s, 1000. * s, 1e-3 * s, 1e-12 * m, 1e-12, {.max_steps = 10});
+    CHECK(res.status == ode::rk45_status::too_many_steps);
+    CHECK(res.accepted + res.rejected == 10);
+  }
+
+  SECTION("many systems in parallel")
+  {
+    std::vector<length> states = {1. * m, 2. * m, 3. * m};
+    const std::vector<ode::rk45_status> status =
+      ode::integrate_rk45(decay, std::span(states), 0. * s, 3. * s, 0.1 * s, 1e-9 * m, 1e-9, {}, 2);
+    for (std::size_t i = 0; i < states.size(); ++i) {
+      CHECK(status[i] == ode::rk45_status::success);
+      CHECK(std::abs(states[i].numerical_value_in(m) - exact_decay(static_cast<double>(i + 1), 3.)) < 1e-7);
+    }
+  }
+}
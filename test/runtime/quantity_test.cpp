@@ -25,7 +25,12 @@
 import std;
 #else
 #include <atomic>
+#include <cstdint>
+#include <functional>
 #include <numbers>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #endif
 #ifdef MP_UNITS_MODULES
 import mp_units;
@@ -82,3 +87,36 @@ TEST_CASE("quantity operations", "[quantity]")
     REQUIRE(quantity(vint * m).numerical_value_in(m) == 123);
   }
 }
+
+TEST_CASE("quantity hashing", "[quantity][hash]")
+{
+  SECTION("hash of a quantity is the hash of its numerical value in its own unit")
+  {
+    CHECK(std::hash<quantity<si::metre, int>>{}(42 * m) == std::hash<int>{}(42));
+    CHECK(std::hash<quantity<si::kilo<si::metre>>>{}(1.5 * km) == std::hash<double>{}(1.5));
+    CHECK(std::hash<quantity<isq::length[m]>>{}(2. * isq::length[m]) == std::hash<double>{}(2.));
+  }
+
+  SECTION("hash of a quantity point is the hash of the quantity from its origin")
+  {
+    const auto qp = point<deg_C>(21);
+    CHECK(std::hash<std::remove_const_t<decltype(qp)>>{}(qp) == std::hash<int>{}(21));
+
+    const auto ts = quantity_point{std::int64_t{7} * s};
+    CHECK(std::hash<std::remove_const_t<decltype(ts)>>{}(ts) == std::hash<std::int64_t>{}(7));
+  }
+
+  SECTION("quantities as keys of unordered containers")
+  {
+    std::unordered_map<quantity<si::metre, int>, int> bins;
+    for (int v : {1, 5, 1, 3, 5, 1}) ++bins[v * m];
+    CHECK(bins.size() == 3);
+    CHECK(bins[1 * m] == 3);
+    CHECK(bins[5 * m] == 2);
+
+    // keys of different units have to be converted to the common type of the container first
+    std::unordered_set<quantity<si::metre, int>> distances{1000 * m, 2000 * m};
+    CHECK(distances.contains((1 * km).in(m)));
+    CHECK(distances.contains(quantity<si::metre, int>(2 * km)));
+  }
+}
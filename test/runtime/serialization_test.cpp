@@ -0,0 +1,278 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch_test_macros.hpp>
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/serialization.h>
+#include <mp-units/systems/isq.h>
+#include <mp-units/systems/si.h>
+#endif
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+namespace {
+
+inline constexpr struct warm_point final : relative_point_origin<si::ice_point + delta<deg_C>(10)> {
+} warm_point;
+
+// schema hashes
+static_assert(binary_schema_hash<quantity<m, double>> == binary_schema_hash<quantity<si::metre, double>>);
+static_assert(binary_schema_hash<quantity<m, double>> != binary_schema_hash<quantity<km, double>>);
+static_assert(binary_schema_hash<quantity<m, double>> != binary_schema_hash<quantity<m, float>>);
+static_assert(binary_schema_hash<quantity<m, int>> != binary_schema_hash<quantity<m, unsigned>>);
+static_assert(binary_schema_hash<quantity<m, double>> != binary_schema_hash<quantity<isq::length[m], double>>);
+static_assert(binary_schema_hash<quantity<isq::height[m], double>> !=
+              binary_schema_hash<quantity<isq::width[m], double>>);
+static_assert(binary_schema_hash<quantity<Hz, double>> != binary_schema_hash<quantity<Bq, double>>);
+static_assert(binary_schema_hash<quantity_point<K, si::zeroth_kelvin, double>> !=
+              binary_schema_hash<quantity<K, double>>);
+static_assert(binary_schema_hash<quantity_point<K, si::zeroth_kelvin, double>> !=
+              binary_schema_hash<quantity_point<K, si::ice_point, double>>);
+static_assert(binary_schema_hash<quantity_point<deg_C, si::ice_point, double>> !=
+              binary_schema_hash<quantity_point<deg_C, warm_point, double>>);
+
+// golden values (the hashes have to be the same for all compilers and platforms)
+static_assert(binary_schema_hash<quantity<m, double>> == 0x2d83'0465'7864'c395);
+static_assert(binary_schema_hash<quantity<isq::height[km], float>> == 0xfb34'6a29'8104'd391);
+static_assert(binary_schema_hash<quantity<m / s, std::int32_t>> == 0x1089'2a75'1b89'fe55);
+static_assert(binary_schema_hash<quantity_point<isq::height[m], zeroth_point_origin<isq::height>, double>> ==
+              0x867a'70ea'3bbf'1e5f);
+static_assert(binary_schema_hash<quantity_point<K, si::zeroth_kelvin, double>> == 0xd234'157d'1908'1f87);
+static_assert(binary_schema_hash<quantity_point<deg_C, si::ice_point, double>> == 0xffaf'eaff'7254'5233);
+static_assert(binary_schema_hash<quantity_point<deg_C, warm_point, double>> == 0xa074'b52c'4ace'1deb);
+
+// supported representation types
+static_assert(BinarySerializable<quantity<m, std::int8_t>>);
+static_assert(BinarySerializable<quantity<m, std::uint64_t>>);
+static_assert(BinarySerializable<quantity<m, float>>);
+static_assert(!BinarySerializable<quantity<m, long double>>);
+static_assert(BinarySerializable<quantity_point<K, si::zeroth_kelvin, float>>);
+
+using length_km = quantity<km, int>;
+using length_m = quantity<m, double>;
+
+std::vector<std::byte> make_message(std::span<const length_km> values)
+{
+  std::vector<std::byte> message;
+  write_binary(message, values);
+  return message;
+}
+
+}  // namespace
+
+TEST_CASE("binary messages", "[serialization]")
+{
+  const std::vector<length_km> values{1 * km, -2 * km, 3 * km};
+  const std::vector<std::byte> message = make_message(values);
+  REQUIRE(message.size() == binary_header_size + values.size() * sizeof(int));
+
+  SECTION("matching schema is read in place")
+  {
+    const binary_quantity_view view = read_binary<length_km>(message);
+    REQUIRE(!view.converting());
+    REQUIRE(view.size() == 3);
+    REQUIRE(view[0] == 1 * km);
+    REQUIRE(view[1] == -2 * km);
+    REQUIRE(view[2] == 3 * km);
+  }
+
+  SECTION("compatible schema is converted")
+  {
+    const binary_quantity_view view = read_binary<length_m, length_km>(message);
+    REQUIRE(view.converting());
+    std::vector<length_m> res;
+    for (const length_m q : view.values()) res.push_back(q);
+    REQUIRE(res == std::vector<length_m>{1000. * m, -2000. * m, 3000. * m});
+  }
+
+  SECTION("incompatible schema fails")
+  {
+    REQUIRE_THROWS_AS(read_binary<length_m>(message), std::invalid_argument);
+    REQUIRE_THROWS_AS((read_binary<quantity<s, double>, quantity<s, int>>(message)), std::invalid_argument);
+  }
+
+  SECTION("truncated message fails")
+  {
+    REQUIRE_THROWS_AS(read_binary<length_km>(std::span(message).first(message.size() - 1)), std::invalid_argument);
+    REQUIRE_THROWS_AS(read_binary<length_km>(std::span(message).first(binary_header_size - 1)), std::invalid_argument);
+  }
+
+  SECTION("corrupted header fails")
+  {
+    std::vector<std::byte> corrupted = message;
+    corrupted[0] = std::byte{'X'};
+    REQUIRE_THROWS_AS(read_binary<length_km>(corrupted), std::invalid_argument);
+  }
+
+  SECTION("multiple messages in one buffer")
+  {
+    std::vector<std::byte> buffer = message;
+    write_binary(buffer, std::span<const length_km>(values).first(1));
+    const binary_quantity_view second = read_binary<length_km>(std::span(buffer).subspan(message.size()));
+    REQUIRE(second.size() == 1);
+    REQUIRE(second[0] == 1 * km);
+  }
+}
+
+TEST_CASE("binary streams", "[serialization]")
+{
+  std::stringstream stream;
+  {
+    binary_writer<length_km> writer(stream);
+    writer.write(5 * km);
+    writer.write(std::vector<length_km>{6 * km, 7 * km});
+  }
+
+  SECTION("matching schema")
+  {
+    binary_reader<length_km> reader(stream);
+    REQUIRE(!reader.converting());
+    REQUIRE(reader.read().value() == 5 * km);
+    REQUIRE(reader.read().value() == 6 * km);
+    REQUIRE(reader.read().value() == 7 * km);
+    REQUIRE(!reader.read());
+  }
+
+  SECTION("compatible schema")
+  {
+    binary_reader<length_m, length_km> reader(stream);
+    REQUIRE(reader.converting());
+    REQUIRE(reader.read().value() == 5000. * m);
+  }
+
+  SECTION("incompatible schema")
+  {
+    REQUIRE_THROWS_AS(binary_reader<length_m>(stream), std::invalid_argument);
+  }
+
+  SECTION("empty stream")
+  {
+    std::stringstream empty;
+    REQUIRE_THROWS_AS(binary_reader<length_km>(empty), std::invalid_argument);
+  }
+}
+
+TEST_CASE("columnar archives", "[serialization]")
+{
+  using temperature = quantity_point<K, si::zeroth_kelvin, double>;
+  using pressure = quantity<Pa, float>;
+  const std::vector<temperature> temperatures{point<K>(273.15), point<K>(300.)};
+  const std::vector<pressure> pressures{101'325.f * Pa, 100'000.f * Pa, 99'000.f * Pa};
+
+  std::ostringstream os;
+  write_columnar(os, columnar_column{"temperature", temperatures}, columnar_column{"pressure", pressures});
+  const std::string file = os.str();
+  // copy to a buffer aligned as a memory-mapped file
+  std::vector<std::uint64_t> storage((file.size() + 7) / 8);
+  std::memcpy(storage.data(), file.data(), file.size());
+  const std::span<const std::byte> data(reinterpret_cast<const std::byte*>(storage.data()), file.size());
+  const columnar_archive archive(data);
+
+  SECTION("header describes the columns")
+  {
+    REQUIRE(archive.columns().size() == 2);
+    const columnar_column_info& t = archive.columns()[0];
+    CHECK(t.name == "temperature");
+    CHECK(t.unit == "K");
+    CHECK(t.rep == "double");
+    CHECK(!t.point_origin.empty());
+    CHECK(t.schema_hash == binary_schema_hash<temperature>);
+    CHECK(t.size == 2);
+    CHECK(t.rep_size == sizeof(double));
+    const columnar_column_info& p = archive.columns()[1];
+    CHECK(p.name == "pressure");
+    CHECK(p.unit == "Pa");
+    CHECK(p.point_origin.empty());
+    CHECK(p.size == 3);
+    CHECK(p.rep_size == sizeof(float));
+    CHECK(archive.contains("pressure"));
+    CHECK(!archive.contains("humidity"));
+  }
+
+  SECTION("columns are accessed in place")
+  {
+    const std::span<const temperature> t = archive.column<temperature>("temperature");
+    REQUIRE(t.size() == 2);
+    CHECK(t[1] == temperatures[1]);
+    CHECK(reinterpret_cast<std::uintptr_t>(t.data()) % columnar_alignment ==
+          reinterpret_cast<std::uintptr_t>(data.data()) % columnar_alignment);
+    const std::span<const pressure> p = archive.column<pressure>("pressure");
+    REQUIRE(p.size() == 3);
+    CHECK(p[0] == pressures[0]);
+    CHECK(p[2] == pressures[2]);
+  }
+
+  SECTION("columns are converted lazily")
+  {
+    const auto p = archive.view<quantity<hPa, float>, pressure>("pressure");
+    REQUIRE(p.converting());
+    REQUIRE(p.size() == 3);
+    CHECK(p[0] == 1013.25f * hPa);
+    const auto t = archive.view<quantity_point<deg_C, si::ice_point, double>, temperature>("temperature");
+    REQUIRE(t.size() == 2);
+    CHECK(t[0].quantity_from(si::ice_point) == delta<deg_C>(0.));
+  }
+
+  SECTION("incompatible columns fail")
+  {
+    CHECK_THROWS_AS((archive.column<quantity<Pa, double>>("pressure")), std::invalid_argument);
+    CHECK_THROWS_AS((archive.view<quantity<hPa, float>>("pressure")), std::invalid_argument);
+    CHECK_THROWS_AS(archive.column<pressure>("humidity"), std::invalid_argument);
+  }
+
+  SECTION("columns with a mismatched size of values fail")
+  {
+    // the first descriptor directly follows the header; its size of values is stored at byte 24
+    std::vector<std::uint64_t> corrupted = storage;
+    reinterpret_cast<std::byte*>(corrupted.data())[16 + 24] = std::byte{1};
+    const columnar_archive bad(std::span(reinterpret_cast<const std::byte*>(corrupted.data()), file.size()));
+    REQUIRE(bad.columns()[0].rep_size == 1);
+    CHECK_THROWS_AS(bad.column<temperature>("temperature"), std::invalid_argument);
+    CHECK_THROWS_AS((bad.view<temperature>("temperature")), std::invalid_argument);
+    CHECK_THROWS_AS((bad.view<quantity_point<deg_C, si::ice_point, double>, temperature>("temperature")),
+                    std::invalid_argument);
+    CHECK(bad.column<pressure>("pressure").size() == 3);
+  }
+
+  SECTION("truncated archive fails")
+  {
+    CHECK_THROWS_AS(columnar_archive(data.first(data.size() - columnar_alignment)), std::invalid_argument);
+    CHECK_THROWS_AS(columnar_archive(data.first(8)), std::invalid_argument);
+  }
+}
@@ -0,0 +1,227 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "geographic.h"
+#include "terrain.h"
+#include <catch2/catch_test_macros.hpp>
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/si.h>
+#endif
+
+using namespace geographic;
+using namespace geographic::literals;
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+namespace {
+
+// bilinear in the row and the column so the sampling reproduces it exactly everywhere
+double height_at(double row, double col) { return 10. * row + 3. * col + row * col; }
+
+std::vector<terrain_sample> make_samples(const terrain_grid_info& info)
+{
+  std::vector<terrain_sample> samples;
+  for (std::uint32_t r = 0; r < info.rows; ++r)
+    for (std::uint32_t c = 0; c < info.cols; ++c)
+      samples.emplace_back(static_cast<std::int16_t>(height_at(r, c)) * isq::altitude[si::metre], mean_sea_level);
+  return samples;
+}
+
+// the contents of a terrain grid file aligned as a memory-mapped file
+struct grid_file {
+  std::vector<std::uint64_t> storage;
+  std::size_t size;
+
+  explicit grid_file(const std::string& contents) : storage((contents.size() + 7) / 8), size(contents.size())
+  {
+    std::memcpy(storage.data(), contents.data(), contents.size());
+  }
+
+  [[nodiscard]] std::span<const std::byte> bytes() const
+  {
+    return {reinterpret_cast<const std::byte*>(storage.data()), size};
+  }
+};
+
+std::string write_grid(const terrain_grid_info& info)
+{
+  std::ostringstream os;
+  write_terrain_grid(os, info, make_samples(info));
+  return os.str();
+}
+
+double metres(msl_altitude alt) { return alt.quantity_from(mean_sea_level).numerical_value_in(si::metre); }
+
+// 1 degree spacing with the samples at integral latitudes and longitudes; 3 x 3 tiles of 2 x 2 samples
+// with the last row and column of tiles padded
+const terrain_grid_info info = {0. * deg, 0. * deg, 1. * deg, 5, 6, 2};
+
+}  // namespace
+
+TEST_CASE("terrain grid files", "[terrain]")
+{
+  const std::string contents = write_grid(info);
+  const grid_file file(contents);
+
+  SECTION("round trip")
+  {
+    const terrain_grid grid(file.bytes());
+    CHECK(grid.info().south == info.south);
+    CHECK(grid.info().west == info.west);
+    CHECK(grid.info().spacing == info.spacing);
+    CHECK(grid.info().rows == info.rows);
+    CHECK(grid.info().cols == info.cols);
+    CHECK(grid.info().tile_size == info.tile_size);
+    CHECK(grid.tiles_y() == 3);
+    CHECK(grid.tiles_x() == 3);
+    const std::vector<terrain_sample> samples = make_samples(info);
+    for (std::uint32_t r = 0; r < info.rows; ++r)
+      for (std::uint32_t c = 0; c < info.cols; ++c) CHECK(grid.at(r, c) == samples[r * info.cols + c]);
+    // the padding repeats the last row
+    CHECK(grid.tile(2, 0)[2] == samples[4 * info.cols]);
+  }
+
+  SECTION("truncated file fails")
+  {
+    CHECK_THROWS_AS(terrain_grid(file.bytes().first(63)), std::invalid_argument);
+    CHECK_THROWS_AS(terrain_grid(file.bytes().first(file.size - 1)), std::invalid_argument);
+    CHECK_THROWS_AS(terrain_grid(file.bytes().first(64)), std::invalid_argument);
+  }
+
+  SECTION("invalid header fails")
+  {
+    auto corrupt = [&](std::size_t offset, auto value) {
+      grid_file res(contents);
+      std::memcpy(reinterpret_cast<std::byte*>(res.storage.data()) + offset, &value, sizeof(value));
+      return res;
+    };
+    CHECK_THROWS_AS(terrain_grid(corrupt(0, 'X').bytes()), std::invalid_argument);
+    CHECK_THROWS_AS(terrain_grid(corrupt(4, std::uint32_t{2}).bytes()), std::invalid_argument);
+    CHECK_THROWS_AS(terrain_grid(corrupt(8, std::uint32_t{1}).bytes()), std::invalid_argument);
+    CHECK_THROWS_AS(terrain_grid(corrupt(16, std::uint32_t{0}).bytes()), std::invalid_argument);
+    CHECK_THROWS_AS(terrain_grid(corrupt(16, std::uint32_t{4097}).bytes()), std::invalid_argument);
+    CHECK_THROWS_AS(terrain_grid(corrupt(40, 0.).bytes()), std::invalid_argument);
+  }
+
+  SECTION("sizes overflowing the file fail")
+  {
+    // the numbers of tiles and samples are huge and their products must not wrap around
+    grid_file huge = file;
+    constexpr std::uint32_t max = 0xFFFF'FFFF;
+    std::memcpy(reinterpret_cast<std::byte*>(huge.storage.data()) + 8, &max, sizeof(max));
+    std::memcpy(reinterpret_cast<std::byte*>(huge.storage.data()) + 12, &max, sizeof(max));
+    CHECK_THROWS_AS(terrain_grid(huge.bytes()), std::invalid_argument);
+    constexpr std::uint32_t tile_size = 4096;
+    std::memcpy(reinterpret_cast<std::byte*>(huge.storage.data()) + 16, &tile_size, sizeof(tile_size));
+    CHECK_THROWS_AS(terrain_grid(huge.bytes()), std::invalid_argument);
+  }
+}
+
+TEST_CASE("terrain cache", "[terrain]")
+{
+  const grid_file file(write_grid(info));
+  const terrain_grid grid(file.bytes());
+
+  SECTION("bilinear sampling")
+  {
+    terrain_cache cache(grid, 4);
+    CHECK(metres(cache.sample(position<long double>{0._N, 0._E})) == height_at(0, 0));
+    CHECK(metres(cache.sample(position<long double>{4._N, 5._E})) == height_at(4, 5));
+    CHECK(metres(cache.sample(position<long double>{0.5_N, 0.25_E})) == height_at(0.5, 0.25));
+    // across the edges of the tiles, where the samples come from the northern and eastern neighbors
+    CHECK(metres(cache.sample(position<long double>{1.5_N, 1.25_E})) == height_at(1.5, 1.25));
+    CHECK(metres(cache.sample(position<long double>{1.75_N, 3.5_E})) == height_at(1.75, 3.5));
+    CHECK(metres(cache.sample(position<long double>{3.25_N, 4.75_E})) == height_at(3.25, 4.75));
+    // outside of the grid the positions are clamped to its edges
+    CHECK(metres(cache.sample(position<long double>{1._S, 2._E})) == height_at(0, 2));
+    CHECK(metres(cache.sample(position<long double>{10._N, 10._E})) == height_at(4, 5));
+  }
+
+  SECTION("batch sampling equals single sampling")
+  {
+    terrain_cache cache(grid, 1);
+    const std::vector<position<long double>> positions = {{0.5_N, 0.5_E}, {3.5_N, 4.5_E}, {2.25_N, 1.75_E}};
+    std::vector<msl_altitude> out(positions.size());
+    cache.sample(std::span<const position<long double>>(positions), std::span(out));
+    for (std::size_t i = 0; i < positions.size(); ++i) CHECK(out[i] == cache.sample(positions[i]));
+  }
+
+  SECTION("profile includes both ends")
+  {
+    terrain_cache cache(grid, 4);
+    std::vector<msl_altitude> out(5);
+    cache.profile(position<long double>{1._N, 1._E}, position<long double>{1._N, 4._E}, std::span(out));
+    // the positions along the path go through the trigonometric functions
+    CHECK(std::abs(metres(out.front()) - height_at(1, 1)) < 1e-9);
+    CHECK(std::abs(metres(out.back()) - height_at(1, 4)) < 1e-9);
+  }
+
+  SECTION("least recently used tiles are evicted")
+  {
+    terrain_cache cache(grid, 2);
+    // the samples at the nodes of the first row hit the tiles 0, 1, and 2 of that row
+    const position<long double> tile0{0._N, 0._E}, tile1{0._N, 2._E}, tile2{0._N, 4._E};
+    (void)cache.sample(tile0);
+    (void)cache.sample(tile1);
+    CHECK(cache.misses() == 2);
+    CHECK(cache.hits() == 0);
+    CHECK(cache.size() == 2);
+
+    // the most recently used tile is checked first and a hit moves a tile to the front
+    (void)cache.sample(tile1);
+    (void)cache.sample(tile0);
+    CHECK(cache.hits() == 2);
+    CHECK(cache.misses() == 2);
+
+    // tile 1 is the least recently used one now
+    (void)cache.sample(tile2);
+    CHECK(cache.misses() == 3);
+    CHECK(cache.size() == 2);
+    (void)cache.sample(tile0);
+    CHECK(cache.hits() == 3);
+    (void)cache.sample(tile1);
+    CHECK(cache.misses() == 4);
+    // tile 2 was evicted by tile 1
+    (void)cache.sample(tile0);
+    CHECK(cache.hits() == 4);
+    (void)cache.sample(tile2);
+    CHECK(cache.misses() == 5);
+    CHECK(cache.size() == 2);
+  }
+}
@@ -0,0 +1,189 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "timing_probes.h"
+#include <catch2/catch_test_macros.hpp>
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/si.h>
+#endif
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+namespace {
+
+// a clock advanced only by the test
+struct manual_clock {
+  using rep = std::int64_t;
+  using period = std::micro;
+  using duration = std::chrono::duration<rep, period>;
+  using time_point = std::chrono::time_point<manual_clock>;
+  static constexpr bool is_steady = true;
+
+  static inline time_point current{};
+  [[nodiscard]] static time_point now() noexcept { return current; }
+};
+
+template<std::size_t Capacity>
+[[nodiscard]] std::vector<std::int64_t> drain_all(probes::ring_buffer<Capacity>& buffer, std::uint64_t& dropped)
+{
+  std::vector<std::int64_t> values;
+  dropped = buffer.drain([&](probes::duration d) { values.push_back(d.numerical_value_in(ns)); });
+  return values;
+}
+
+}  // namespace
+
+TEST_CASE("scoped timer records the lifetime of a scope", "[timing_probes]")
+{
+  probes::counter c;
+  {
+    const probes::scoped_timer<probes::counter, manual_clock> timer(c);
+    manual_clock::current += std::chrono::microseconds{3};
+    CHECK(timer.elapsed() == 3 * us);
+    manual_clock::current += std::chrono::microseconds{2};
+  }
+  {
+    const probes::scoped_timer<probes::counter, manual_clock> timer(c);
+    manual_clock::current += std::chrono::microseconds{7};
+  }
+
+  CHECK(c.count() == 2);
+  CHECK(c.total() == 12 * us);
+  CHECK(c.mean() == 6 * us);
+}
+
+TEST_CASE("histogram reports the power-of-two bucket of a quantile", "[timing_probes]")
+{
+  probes::histogram h;
+  CHECK(h.quantile(0.5) == 0 * ns);
+  CHECK(h.quantile(1.) == 0 * ns);
+
+  for (int i = 0; i < 90; ++i) h.record(100 * ns);
+  for (int i = 0; i < 10; ++i) h.record(5 * us);
+  h.record(-1 * ns);
+
+  CHECK(h.count() == 101);
+  CHECK(h.quantile(0.5) == 128 * ns);
+  CHECK(h.quantile(0.99) == 8192 * ns);
+  CHECK(h.quantile(0.) == 1 * ns);
+  CHECK(h.quantile(1.) == 8192 * ns);
+
+  h.record(std::numeric_limits<std::int64_t>::max() * ns);
+  CHECK(h.quantile(1.) == std::numeric_limits<std::int64_t>::max() * ns);
+}
+
+TEST_CASE("ring buffer drains the recorded measurements", "[timing_probes]")
+{
+  probes::ring_buffer<4> buffer;
+  std::uint64_t dropped = 42;
+
+  SECTION("nothing recorded")
+  {
+    CHECK(drain_all(buffer, dropped).empty());
+    CHECK(dropped == 0);
+  }
+
+  SECTION("fewer measurements than the capacity")
+  {
+    for (std::int64_t i = 1; i <= 3; ++i) buffer.record(i * ns);
+    CHECK(drain_all(buffer, dropped) == std::vector<std::int64_t>{1, 2, 3});
+    CHECK(dropped == 0);
+
+    // the next call returns only the new measurements
+    buffer.record(4 * ns);
+    buffer.record(5 * ns);
+    CHECK(drain_all(buffer, dropped) == std::vector<std::int64_t>{4, 5});
+    CHECK(dropped == 0);
+    CHECK(drain_all(buffer, dropped).empty());
+    CHECK(dropped == 0);
+  }
+
+  SECTION("exactly the capacity")
+  {
+    for (std::int64_t i = 1; i <= 4; ++i) buffer.record(i * ns);
+    CHECK(drain_all(buffer, dropped) == std::vector<std::int64_t>{1, 2, 3, 4});
+    CHECK(dropped == 0);
+  }
+
+  SECTION("the oldest measurements are overwritten and counted as dropped")
+  {
+    for (std::int64_t i = 1; i <= 11; ++i) buffer.record(i * ns);
+    CHECK(drain_all(buffer, dropped) == std::vector<std::int64_t>{8, 9, 10, 11});
+    CHECK(dropped == 7);
+
+    // the counters start over after a drain
+    for (std::int64_t i = 12; i <= 17; ++i) buffer.record(i * ns);
+    CHECK(drain_all(buffer, dropped) == std::vector<std::int64_t>{14, 15, 16, 17});
+    CHECK(dropped == 2);
+  }
+
+  SECTION("the slots overwritten while draining are dropped instead of delivered")
+  {
+    for (std::int64_t i = 1; i <= 4; ++i) buffer.record(i * ns);
+
+    // the producer records 3 more values after the value 1 was delivered, which overwrites the slots of
+    // the values 1-3, so only the values 2 and 3 are lost
+    std::vector<std::int64_t> values;
+    bool first = true;
+    dropped = buffer.drain([&](probes::duration d) {
+      values.push_back(d.numerical_value_in(ns));
+      if (first) {
+        first = false;
+        for (std::int64_t i = 5; i <= 7; ++i) buffer.record(i * ns);
+      }
+    });
+    CHECK(values == std::vector<std::int64_t>{1, 4});
+    CHECK(dropped == 2);
+
+    // the values recorded during the drain are delivered by the next one
+    CHECK(drain_all(buffer, dropped) == std::vector<std::int64_t>{5, 6, 7});
+    CHECK(dropped == 0);
+  }
+
+  SECTION("a full buffer is drained completely when nothing overwrites it during the drain")
+  {
+    for (std::int64_t i = 1; i <= 4; ++i) buffer.record(i * ns);
+
+    // the next value overwrites only the slot of the value 1 that was already delivered
+    std::vector<std::int64_t> values;
+    dropped = buffer.drain([&](probes::duration d) {
+      values.push_back(d.numerical_value_in(ns));
+      if (values.size() == 2) buffer.record(5 * ns);
+    });
+    CHECK(values == std::vector<std::int64_t>{1, 2, 3, 4});
+    CHECK(dropped == 0);
+    CHECK(drain_all(buffer, dropped) == std::vector<std::int64_t>{5});
+  }
+}
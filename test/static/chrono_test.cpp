@@ -105,6 +105,13 @@ static_assert(
 static_assert(is_of_type<quantity_point{sys_days{sys_days::duration{1}}},
                          time_point<si::day, std::chrono::system_clock, sys_days::rep>>);
 
+// reading clocks
+static_assert(std::same_as<decltype(now<std::chrono::system_clock>()),
+                           decltype(quantity_point{std::chrono::system_clock::now()})>);
+static_assert(std::same_as<decltype(now<std::chrono::steady_clock>())::rep, std::chrono::steady_clock::rep>);
+static_assert(decltype(now<std::chrono::steady_clock>())::point_origin ==
+              chrono_point_origin<std::chrono::steady_clock>);
+
 // conversion to chrono
 static_assert(
   std::constructible_from<std::chrono::seconds, quantity<isq::time[si::second], std::chrono::seconds::rep>>);
@@ -176,4 +176,29 @@ static_assert(baillie_psw_probable_prime(9'007'199'254'740'881u), "Large known p
 
 static_assert(baillie_psw_probable_prime(18'446'744'073'709'551'557u), "Largest 64-bit prime");
 
+
+// Complete prime factorization.
+template<std::size_t N>
+constexpr bool has_factors(const prime_factors& f, const std::array<prime_power, N>& expected)
+{
+  if (f.size != N) return false;
+  for (std::size_t i = 0; i < N; ++i)
+    if (f.factors[i].prime != expected[i].prime || f.factors[i].power != expected[i].power) return false;
+  return true;
+}
+
+static_assert(factorize(1u).size == 0);
+static_assert(has_factors(factorize(2u), std::array<prime_power, 1>{{{2, 1}}}));
+static_assert(has_factors(factorize(792u), std::array<prime_power, 3>{{{2, 3}, {3, 2}, {11, 1}}}));
+static_assert(has_factors(factorize(1'609'344u), std::array<prime_power, 4>{{{2, 7}, {3, 2}, {11, 1}, {127, 1}}}));
+static_assert(has_factors(factorize(44'482'216'152'605u),
+                          std::array<prime_power, 6>{{{5, 1}, {7, 2}, {11, 1}, {97, 1}, {6073, 1}, {28019, 1}}}));
+static_assert(has_factors(factorize(334'524'384'739u), std::array<prime_power, 1>{{{334'524'384'739u, 1}}}));
+static_assert(has_factors(factorize(547u * 557u), std::array<prime_power, 2>{{{547, 1}, {557, 1}}}));
+static_assert(has_factors(factorize(598'419'795'254u),
+                          std::array<prime_power, 3>{{{2, 1}, {547, 2}, {1'000'003u, 1}}}));
+static_assert(has_factors(factorize(18'446'744'073'709'551'557u),
+                          std::array<prime_power, 1>{{{18'446'744'073'709'551'557u, 1}}}));
+static_assert(prime_factors_v<1'609'344u>.size == 4);
+
 }  // namespace
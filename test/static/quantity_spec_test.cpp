@@ -512,6 +512,21 @@ static_assert(have_common_base(width, length));
 static_assert(have_common_base(width, height));
 static_assert(have_common_base(angular_measure, dimensionless));
 static_assert(have_common_base(angular_measure, solid_angular_measure));
+static_assert(!have_common_base(length, time));
+
+static_assert(get_common_base(width, height) == length);
+static_assert(get_common_base(width, length) == length);
+static_assert(get_common_base(radius, width) == width);
+static_assert(get_common_base(angular_measure, solid_angular_measure) == dimensionless);
+
+static_assert(is_child_of(width, length));
+static_assert(is_child_of(radius, length));
+static_assert(!is_child_of(length, width));
+static_assert(!is_child_of(width, height));
+static_assert(!is_child_of(length, length));
+
+static_assert(get_hierarchy_root(radius) == length);
+static_assert(get_hierarchy_root(angular_measure) == dimensionless);
 
 static_assert(convertible_common_base(width, length) == yes);
 static_assert(convertible_common_base(length, width) == explicit_conversion);
@@ -37,6 +37,7 @@ import std;
 #else
 #include <concepts>
 #include <cstdint>
+#include <functional>
 #include <limits>
 #include <type_traits>
 #include <utility>
@@ -1313,6 +1314,15 @@ static_assert(is_same_v<std::common_type_t<quantity<isq::angular_measure[one], d
                         quantity<isq::angular_measure[one], double>>);
 
 
+//////////////////
+// hash
+//////////////////
+
+static_assert(std::is_default_constructible_v<std::hash<quantity<isq::length[m], int>>>);
+static_assert(std::is_default_constructible_v<std::hash<quantity<isq::length[m], double>>>);
+static_assert(!std::is_default_constructible_v<std::hash<quantity<isq::displacement[m], cartesian_vector<double>>>>);
+
+
 //////////////////
 // value_cast
 //////////////////
@@ -25,7 +25,9 @@
 #ifdef MP_UNITS_IMPORT_STD
 import std;
 #else
+#include <cstddef>
 #include <type_traits>
+#include <utility>
 #endif
 
 namespace {
@@ -118,6 +120,15 @@ static_assert(is_same_v<type_list_join<type_list<int>, type_list<long>>, type_li
 static_assert(
   is_same_v<type_list_join<type_list<int, long>, type_list<float, double>>, type_list<int, long, float, double>>);
 
+// type_list_slice
+
+static_assert(is_same_v<type_list_slice<type_list<>, 0, 0>, type_list<>>);
+static_assert(is_same_v<type_list_slice<type_list<int, long, double>, 0, 0>, type_list<>>);
+static_assert(is_same_v<type_list_slice<type_list<int, long, double>, 0, 3>, type_list<int, long, double>>);
+static_assert(is_same_v<type_list_slice<type_list<int, long, double>, 1, 2>, type_list<long>>);
+static_assert(is_same_v<type_list_slice<type_list<int, long, double>, 1, 3>, type_list<long, double>>);
+static_assert(is_same_v<type_list_slice<type_list<int, long, double>, 3, 3>, type_list<>>);
+
 // type_list_split
 
 static_assert(is_same_v<type_list_split<type_list<int>, 0>::first_list, type_list<>>);
@@ -191,6 +202,48 @@ static_assert(
 static_assert(is_same_v<type_list_merge_sorted<type_list<v1, v2, v3>, type_list<v1, v2, v4>, constant_less>,
                         type_list<v1, v1, v2, v2, v3, v4>>);
 
+template<typename Seq, std::size_t Step, std::size_t Offset, template<auto> typename T>
+struct make_constants;
+
+template<std::size_t... Is, std::size_t Step, std::size_t Offset, template<auto> typename T>
+struct make_constants<std::index_sequence<Is...>, Step, Offset, T> {
+  using type = type_list<T<(Is * Step) + Offset>...>;
+};
+
+// `N` constants starting from `Offset` with the distance of `Step` between them
+template<std::size_t N, std::size_t Step = 1, std::size_t Offset = 0, template<auto> typename T = constant>
+using constants = make_constants<std::make_index_sequence<N>, Step, Offset, T>::type;
+
+template<auto V>
+struct other_constant : constant<V> {};
+
+static_assert(
+  is_same_v<type_list_merge_sorted<constants<100, 2>, constants<100, 2, 1>, constant_less>, constants<200>>);
+static_assert(is_same_v<type_list_merge_sorted<constants<10>, constants<90, 1, 10>, constant_less>, constants<100>>);
+static_assert(is_same_v<type_list_merge_sorted<constants<90, 1, 10>, constants<10>, constant_less>, constants<100>>);
+
+template<typename Seq>
+struct make_interleaved;
+
+template<std::size_t... Is>
+struct make_interleaved<std::index_sequence<Is...>> {
+  using type = type_list_join<type_list<other_constant<Is>, constant<Is>>...>;
+};
+
+// equivalent elements of the second list go first
+static_assert(is_same_v<type_list_merge_sorted<constants<40>, constants<40, 1, 0, other_constant>, constant_less>,
+                        make_interleaved<std::make_index_sequence<40>>::type>);
+
+// type_list_partition_point
+
+template<typename T>
+using less_than_v3 = constant_less<T, v3>;
+
+static_assert(type_list_partition_point<type_list<>, less_than_v3> == 0);
+static_assert(type_list_partition_point<type_list<v3, v4>, less_than_v3> == 0);
+static_assert(type_list_partition_point<type_list<v1, v2, v3, v4>, less_than_v3> == 2);
+static_assert(type_list_partition_point<type_list<v1, v2>, less_than_v3> == 2);
+
 // type_list_sort
 
 static_assert(is_same_v<type_list_sort<type_list<>, constant_less>, type_list<>>);
@@ -199,6 +252,9 @@ static_assert(is_same_v<type_list_sort<type_list<v1, v2>, constant_less>, type_l
 static_assert(is_same_v<type_list_sort<type_list<v2, v1>, constant_less>, type_list<v1, v2>>);
 static_assert(is_same_v<type_list_sort<type_list<v2, v1, v3>, constant_less>, type_list<v1, v2, v3>>);
 static_assert(is_same_v<type_list_sort<type_list<v4, v3, v2, v1>, constant_less>, type_list<v1, v2, v3, v4>>);
+static_assert(is_same_v<type_list_sort<constants<100, 1, 0>, constant_less>, constants<100>>);
+static_assert(is_same_v<type_list_sort<type_list_join<constants<50, 2, 1>, constants<50, 2>>, constant_less>,
+                        constants<100>>);
 
 // type_list_unique
 
@@ -451,23 +451,6 @@ static_assert(std::is_same_v<decltype(get_base(power_v<mag_2, 5, 8>{})), mag_2_>
 //   }
 // }
 
-// TEST_CASE("Prime helper functions")
-// {
-//   SECTION("multiplicity")
-//   {
-//     CHECK(multiplicity(2, 8) == 3);
-//     CHECK(multiplicity(2, 1024) == 10);
-//     CHECK(multiplicity(11, 6655) == 3);
-//   }
-
-//   SECTION("remove_power()")
-//   {
-//     CHECK(remove_power(17, 0, 5) == 5);
-//     CHECK(remove_power(2, 3, 24) == 3);
-//     CHECK(remove_power(11, 3, 6655) == 5);
-//   }
-// }
-
 // TEST_CASE("Prime factorization")
 // {
 //   SECTION("1 factors into the null unit_magnitude") { CHECK(prime_factorization_v<1> == unit_magnitude<>{}); }